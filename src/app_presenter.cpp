@@ -82,4 +82,26 @@ void buildPanelData(const MiningSummary& summary, UIMining& ui, UIMining::PanelD
 
   // Pool 診断メッセージ（mining_task から）
   data.poolDiag = summary.poolDiag;
+
+  // ★追加: 遅れの分布（NETWORK ページ）
+  {
+    const MiningLatency* src[3] = {&summary.latJob, &summary.latFeedback, &summary.latConnect};
+    float* dst[3] = {data.lat_job, data.lat_fb, data.lat_conn};
+    for (int i = 0; i < 3; ++i) {
+      dst[i][0] = src[i]->p50;
+      dst[i][1] = src[i]->p95;
+      dst[i][2] = src[i]->p99;
+    }
+  }
+
+  // ★追加: ハッシュレートの時系列（HASH TREND ページ）
+  {
+    static MiningHashrateSeries hs;   // 毎フレーム呼ばれるのでスタックに積まない
+    getMiningHashrateSeries(hs);
+    data.hr_ewma_kh   = hs.ewma_kh;
+    data.hr_minutes_n = hs.nMinutes;
+    data.hr_hours_n   = hs.nHours;
+    memcpy(data.hr_minutes, hs.minutes, sizeof(float) * hs.nMinutes);
+    memcpy(data.hr_hours, hs.hours, sizeof(float) * hs.nHours);
+  }
 }
@@ -30,6 +30,148 @@
   #define MC_CPU_FREQ_MHZ 240
 #endif
 
+// ---- DUCO-S1 カーネル ----
+// 通常は startMiner() で登録済みの全カーネルを測って一番速いものを使う（MC_DUCO_S1_AUTOSELECT）。
+// 下の LANES / VECTOR は自動選択を切ったときに使うカーネル。
+// 1 = 1 本ずつ（オドメータ + 早期棄却） / 2, 4 = 連続 nonce を交互に計算するレーン版
+#ifndef MC_DUCO_S1_LANES
+  #define MC_DUCO_S1_LANES 1
+#endif
+
+// 1 にすると MC_DUCO_S1_LANES（4 / 8 / 16）本を SIMD 版で計算する（ホストビルド向け）。
+// ESP32 には SIMD が無いので、その場合はスカラー版にコンパイル時に落ちる
+#ifndef MC_DUCO_S1_VECTOR
+  #define MC_DUCO_S1_VECTOR 0
+#endif
+
+// 1 = 起動時にキャリブレーションして選ぶ / 0 = 上の固定カーネル
+#ifndef MC_DUCO_S1_AUTOSELECT
+  #define MC_DUCO_S1_AUTOSELECT 1
+#endif
+
+// キャリブレーションで 1 カーネルあたりに解かせるハッシュ数（240MHz で数十 ms 程度）
+#ifndef MC_DUCO_S1_CALIB_HASHES
+  #define MC_DUCO_S1_CALIB_HASHES 20000
+#endif
+
+// ---- 協調モード（1ジョブを全ワーカーで分担）----
+// 既定値（実行中は setMiningCooperative で切り替え）と、1回に配る nonce 数
+#ifndef MC_DUCO_COOP
+  #define MC_DUCO_COOP 0
+#endif
+#ifndef MC_DUCO_COOP_CHUNK
+  #define MC_DUCO_COOP_CHUNK 8192
+#endif
+
+// スレッドを止めたときに保存したジョブを、再開時に使ってよい最大の経過時間 [ms]
+// （これより古いものはサーバー側で期限切れの可能性が高いので捨てて新しい JOB をもらう）
+#ifndef MC_DUCO_PARK_MAX_MS
+  #define MC_DUCO_PARK_MAX_MS (10UL * 60UL * 1000UL)
+#endif
+
+// ---- マイナーのワーカー構成（既定値。実行時は mc_config_store の miner_* で変更、起動時に反映）----
+// MAX はスレッドごとの統計などの静的な領域の大きさ（イベントグループのビット数にも収まること）
+#ifndef MC_MINER_MAX_THREADS
+  #define MC_MINER_MAX_THREADS 8
+#endif
+#ifndef MC_MINER_THREADS
+  #define MC_MINER_THREADS 2
+#endif
+// ワーカー i を置くコア：リストの i 番目（足りなければ先頭から繰り返し）。0 / 1 / a(=どちらでも)
+#ifndef MC_MINER_CORES
+  #define MC_MINER_CORES "0,1"
+#endif
+#ifndef MC_MINER_PRIO
+  #define MC_MINER_PRIO 1
+#endif
+
+// ---- プール I/O タスク（全接続を1本で扱い、ワーカーにジョブを配る）----
+// 取り出す側の数より多めに持っておくジョブ（= 余分に張る接続）の数。
+// 解き終えたワーカーがすぐ次を取れるように 1。0 なら submit〜次の JOB の間はワーカーが待つ
+#ifndef MC_DUCO_IO_SPARE_JOBS
+  #define MC_DUCO_IO_SPARE_JOBS 1
+#endif
+// 結果が来ないときにソケットを見に行く間隔 [ms]（結果が来たら通知ですぐ起きる）
+#ifndef MC_DUCO_IO_POLL_MS
+  #define MC_DUCO_IO_POLL_MS 5
+#endif
+// WiFi スタックと同じコア 0 に、ワーカーより高い優先度で（ほとんど寝ている）
+#ifndef MC_DUCO_IO_CORE
+  #define MC_DUCO_IO_CORE 0
+#endif
+#ifndef MC_DUCO_IO_PRIO
+  #define MC_DUCO_IO_PRIO 2
+#endif
+
+// 1 = パイプライン（submit の直後に次の JOB も送り、返事を順に読む）を既定で有効に。
+// 実行中は setMiningPipelined で切り替え
+#ifndef MC_DUCO_PIPELINE
+  #define MC_DUCO_PIPELINE 0
+#endif
+
+// 画面 / テレメトリの total_kh と submit に載せるハッシュレートをどちらの時間で割るか
+//   0 = 実時間（yield / 一時停止 / 横取りも含む。従来どおり）
+//   1 = 計算時間（yield と一時停止を除く。カーネル自体の速さ）
+// 実行中は setMiningHashratePolicy で切り替え。MiningSummary には両方入る
+#ifndef MC_DUCO_HASHRATE_POLICY
+  #define MC_DUCO_HASHRATE_POLICY 0
+#endif
+// ハッシュレートの時系列（duco_hr_series）の EWMA の時定数 [s]。サンプルは 1 秒ごと
+#ifndef MC_DUCO_HR_EWMA_S
+  #define MC_DUCO_HR_EWMA_S 60.0f
+#endif
+
+// ---- プールノードのキャッシュ（LittleFS: /duco_pool.json）----
+// 起動時はキャッシュのノードで先に繋ぎ、getPool の結果に乗り換えるのは
+// キャッシュがこれより古い [s] か、今のノードへの接続が続けてこの回数失敗したときだけ
+#ifndef MC_DUCO_POOL_CACHE_MAX_AGE_S
+  #define MC_DUCO_POOL_CACHE_MAX_AGE_S (12UL * 3600UL)
+#endif
+#ifndef MC_DUCO_POOL_FAIL_MAX
+  #define MC_DUCO_POOL_FAIL_MAX 3
+#endif
+
+// ---- プールノードの選び方（getPool + pool_nodes + キャッシュの中から一番速いもの）----
+// 候補を測る間隔 [ms]（TCP connect と banner まで。測るたびに各ノードへ1本繋ぐので短くしすぎない）
+#ifndef MC_DUCO_POOL_PROBE_MS
+  #define MC_DUCO_POOL_PROBE_MS (10UL * 60UL * 1000UL)
+#endif
+// 乗り換えるのは、一番良い候補のスコアが今のノードよりこの割合以上 かつ この ms 以上良いときだけ
+#ifndef MC_DUCO_POOL_SWITCH_MARGIN
+  #define MC_DUCO_POOL_SWITCH_MARGIN 0.25f
+#endif
+#ifndef MC_DUCO_POOL_SWITCH_GAP_MS
+  #define MC_DUCO_POOL_SWITCH_GAP_MS 30.0f
+#endif
+// 候補に足すノードの既定値（"host:port,host:port"。実行時は mc_config_store の pool_nodes）
+#ifndef MC_DUCO_POOL_NODES
+  #define MC_DUCO_POOL_NODES ""
+#endif
+
+// ★追加: 直近のジョブの記録（@JOBS）を RAM に何件持つか（1 件 36 バイト）
+#ifndef MC_DUCO_JOB_RING
+  #define MC_DUCO_JOB_RING 64
+#endif
+
+// ★追加: ジョブのトレース（duco_trace）。起動時のモード: 0 = off / 1 = LittleFS / 2 = シリアル
+// （実行時はシリアルの TRACE FS|SERIAL|OFF）
+#ifndef MC_DUCO_TRACE
+  #define MC_DUCO_TRACE 0
+#endif
+// LittleFS の /duco_trace.bin はここまで（超えたら書くのをやめる。1 レコード 60 バイト）
+#ifndef MC_DUCO_TRACE_MAX_BYTES
+  #define MC_DUCO_TRACE_MAX_BYTES (256UL * 1024UL)
+#endif
+
+// ★追加: 通算カウンタ（duco_lifetime。LittleFS の /duco_life.bin、スロット 8 個を順に上書き）。
+// シェアごとには書かず、前に書いてからこの秒数が経つか、受理 + 却下がこの数だけ増えたら書く
+#ifndef MC_DUCO_LIFE_FLUSH_S
+  #define MC_DUCO_LIFE_FLUSH_S 600
+#endif
+#ifndef MC_DUCO_LIFE_FLUSH_SHARES
+  #define MC_DUCO_LIFE_FLUSH_SHARES 256
+#endif
+
 // ★命名を Web/JSON（index.html / mc_config_store）に合わせる
 //   duco_miner_key / az_speech_region / az_speech_key / az_tts_voice など
 struct AppConfig {
@@ -0,0 +1,35 @@
+// src/duco_hr_series.cpp
+#include "duco_hr_series.h"
+
+#include <math.h>
+
+void duco_hr_series_add(DucoHrSeries& s, uint32_t nowMs, float kh, float tauS) {
+  // EWMA（サンプルの間隔がばらついても時定数が変わらないように dt から係数を決める）
+  if (!s.ewma_valid || tauS <= 0.0f) {
+    s.ewma_kh    = kh;
+    s.ewma_valid = true;
+  } else {
+    const float dt = (float)(nowMs - s.last_ms) / 1000.0f;
+    const float a  = 1.0f - expf(-dt / tauS);
+    s.ewma_kh += a * (kh - s.ewma_kh);
+  }
+  s.last_ms = nowMs;
+
+  // 1 分平均
+  if (s.min_n == 0) s.min_start_ms = nowMs;
+  s.min_sum += kh;
+  ++s.min_n;
+  if (nowMs - s.min_start_ms < 60000UL) return;
+
+  const float m = s.min_sum / (float)s.min_n;
+  s.minutes.push(m);
+  s.min_sum = 0.0f;
+  s.min_n   = 0;
+
+  // 1 時間平均（1 分平均 60 個）
+  s.hour_sum += m;
+  if (++s.hour_n < 60) return;
+  s.hours.push(s.hour_sum / (float)s.hour_n);
+  s.hour_sum = 0.0f;
+  s.hour_n   = 0;
+}
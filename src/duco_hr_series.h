@@ -0,0 +1,55 @@
+// src/duco_hr_series.h
+#pragma once
+// ハッシュレートの時系列（固定長のリング。確保なし）
+//
+// 1 秒ごとくらいにサンプルを足すと:
+//   - EWMA（時定数 tauS 秒）でならした今の値
+//   - 直近 DUCO_HR_MINUTES 分の 1 分平均
+//   - 直近 DUCO_HR_HOURS 時間の 1 時間平均（1 分平均 60 個の平均）
+// を持つ。熱でクロックが落ちた / カーネルが遅くなった、のようなゆっくりした変化を見る用。
+// ※ Arduino に依存しない（ホスト側でもそのままビルドできる）こと。
+
+#include <stddef.h>
+#include <stdint.h>
+
+static const size_t DUCO_HR_MINUTES = 60;
+static const size_t DUCO_HR_HOURS   = 24;
+
+// 最後の N 点（古いものから上書き）
+template <size_t N>
+struct DucoHrRing {
+  float    v[N];
+  uint16_t head = 0;   // 次に書く位置
+  uint16_t n    = 0;   // 入っている点の数（<= N）
+
+  void push(float x) {
+    v[head] = x;
+    head = (uint16_t)((head + 1) % N);
+    if (n < N) ++n;
+  }
+  // 古い順に最大 max 点を out へ（一番新しい点が out[戻り値 - 1]）
+  size_t copy(float* out, size_t max) const {
+    const size_t k = (n < max) ? n : max;
+    for (size_t i = 0; i < k; ++i) out[i] = v[(head + N - k + i) % N];
+    return k;
+  }
+};
+
+struct DucoHrSeries {
+  float    ewma_kh    = 0.0f;
+  bool     ewma_valid = false;
+  uint32_t last_ms    = 0;
+
+  // 今の 1 分 / 1 時間の途中
+  float    min_sum      = 0.0f;
+  uint32_t min_n        = 0;
+  uint32_t min_start_ms = 0;
+  float    hour_sum     = 0.0f;
+  uint32_t hour_n       = 0;
+
+  DucoHrRing<DUCO_HR_MINUTES> minutes;
+  DucoHrRing<DUCO_HR_HOURS>   hours;
+};
+
+// サンプルを 1 つ足す（nowMs は単調増加の ms。32bit の折り返しは差で扱う）
+void duco_hr_series_add(DucoHrSeries& s, uint32_t nowMs, float kh, float tauS);
@@ -0,0 +1,630 @@
+// src/duco_io.cpp
+#include "duco_io.h"
+#include "logging.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <lwip/sockets.h>
+
+#include "duco_s1.h"
+#include "esp_timer.h"
+#include "freertos/queue.h"
+
+// 書き手はそのワーカー、読み手は I/O タスクだけなので head / tail の atomic だけで足りる
+static const uint32_t DUCO_RESULT_RING = 4;   // 2 のべき（ワーカーが同時に持つ結果は 1 つ）
+struct DucoResultRing {
+  uint32_t      head = 0;   // 書き手が進める
+  uint32_t      tail = 0;   // 読み手が進める
+  DucoResultMsg buf[DUCO_RESULT_RING];
+};
+
+static DucoIoHooks    g_hooks;
+static int            g_workers = 0;
+static DucoConn       g_conns[DUCO_IO_MAX_CONNS];
+static DucoResultRing g_results[DUCO_IO_MAX_WORKERS];
+static QueueHandle_t  g_jobQ   = nullptr;
+static TaskHandle_t   g_ioTask = nullptr;
+static volatile bool  g_pipeline   = (MC_DUCO_PIPELINE != 0);   // ★追加: submit + JOB をまとめて送る
+static volatile bool  g_hpsCompute = (MC_DUCO_HASHRATE_POLICY == MINING_HR_COMPUTE);
+static bool           g_trace      = false;   // I/O タスクだけが触る
+static uint64_t       g_hashes     = 0;       // I/O タスクだけが触る
+static int            g_want       = 0;       // 直近の duco_io_results / duco_io_step_all の want
+
+// 今使うノード（I/O タスクだけが触る）
+static char     g_host[64] = {0};
+static uint16_t g_port     = 0;
+static char     g_name[40] = {0};
+
+static void io_status_(const char* text) {
+  if (g_hooks.status) g_hooks.status(text);
+}
+
+static void io_diag_(const char* text) {
+  if (g_hooks.diag) g_hooks.diag(text);
+}
+
+static void io_share_(DucoConn& c, bool accepted) {
+  if (accepted) ++c.accepted;
+  else          ++c.rejected;
+  if (g_hooks.share) g_hooks.share(c, accepted);
+}
+
+static inline uint32_t conn_gen_(uint8_t k) {
+  return __atomic_load_n(&g_conns[k].gen, __ATOMIC_RELAXED);
+}
+
+static bool result_push_(DucoResultRing& r, const DucoResultMsg& m) {
+  const uint32_t h = __atomic_load_n(&r.head, __ATOMIC_RELAXED);
+  const uint32_t t = __atomic_load_n(&r.tail, __ATOMIC_ACQUIRE);
+  if (h - t >= DUCO_RESULT_RING) return false;
+  r.buf[h & (DUCO_RESULT_RING - 1)] = m;
+  __atomic_store_n(&r.head, h + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+static bool result_pop_(DucoResultRing& r, DucoResultMsg& m) {
+  const uint32_t t = __atomic_load_n(&r.tail, __ATOMIC_RELAXED);
+  const uint32_t h = __atomic_load_n(&r.head, __ATOMIC_ACQUIRE);
+  if (h == t) return false;
+  m = r.buf[t & (DUCO_RESULT_RING - 1)];
+  __atomic_store_n(&r.tail, t + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+// ワーカーから結果を返して I/O タスクを起こす（リングが詰まっていれば空くまで譲る）
+static void result_post_(int idx, const DucoResultMsg& m) {
+  while (!result_push_(g_results[idx], m)) vTaskDelay(pdMS_TO_TICKS(1));
+  if (g_ioTask) xTaskNotifyGive(g_ioTask);
+}
+
+// ---- I/O タスク側 ----
+
+// 受信済みのバイトを rx に溜め、'\n' まで来たら true（rx.buf は '\0' 終端・末尾の空白なし）
+static bool conn_read_line_(DucoConn& c) {
+  while (c.cli.available()) {
+    const int ch = c.cli.read();
+    if (ch < 0) break;
+    if (duco_line_push(c.rx, (char)ch)) return true;
+  }
+  return false;
+}
+
+// 今のジョブの記録を結果（feedback）で閉じて hooks.record と（トレース中なら）hooks.trace へ
+static void job_finish_(DucoConn& c, uint8_t result) {
+  if (c.jobValid) {
+    c.jobValid   = false;
+    c.job.result = result;
+    c.job.end_ms = millis();
+    if (g_hooks.record) g_hooks.record(c.job);
+  }
+  // DROP は解き終えていないのでトレースには書かない
+  if (c.traceValid && result != MINING_JOB_DROP && g_trace && g_hooks.trace) {
+    c.trace.feedback = result;
+    g_hooks.trace(c.trace);
+  }
+  c.traceValid = false;
+}
+
+// 接続を閉じる。gen を進めるので、このジョブを解いているワーカーは次の制御ポイントで打ち切る
+static void io_close_(DucoConn& c, uint32_t backoffMs) {
+  if (c.state == CONN_WAIT_FB) job_finish_(c, MINING_JOB_LOST);
+  c.jobValid   = false;
+  c.traceValid = false;
+  if (c.connFd >= 0) {
+    close(c.connFd);
+    c.connFd = -1;
+  }
+  c.cli.stop();
+  c.connected = false;
+  __atomic_add_fetch(&c.gen, 1, __ATOMIC_RELAXED);
+  c.state      = CONN_IDLE;
+  c.drain      = false;
+  c.rx.len     = 0;
+  c.jobPending = false;
+  c.resultMs   = 0;
+  c.retry_ms   = millis() + backoffMs;
+}
+
+static void io_ident_(DucoIoIdent& id) {
+  if (g_hooks.ident) g_hooks.ident(id);
+}
+
+// JOB を送る（パイプラインでは submit の直後にも）
+static void io_send_job_(DucoConn& c, uint8_t k) {
+  DucoIoIdent id;
+  io_ident_(id);
+  // Request job（user, board, miningKey）
+  // NOTE:
+  //   ESP32 を名乗ると Kolka に「Too high starting difficulty」と言われて全シェアがリジェクトされる。
+  //   AVR を名乗れば通るが、実際は ESP32 なのでボード名で嘘をつきたくない。
+  //   そのため、汎用スタート難易度ラベル "LOW" を指定し、具体的な難易度調整は
+  //   サーバー側（Kolka）に任せる方針。
+  char req[DUCO_PROTO_TX_MAX];
+  const size_t n = duco_fmt_job_request(req, sizeof(req), id.user, "LOW", id.key);
+  // ★ 追加：何を投げたか（miner_key はログに出さない）
+  mc_logf("[DUCO-C%u] send JOB user=%s board=LOW%s", (unsigned)k, id.user,
+          c.state == CONN_WAIT_FB ? " (pipelined)" : "");
+  if (n) c.cli.write((const uint8_t*)req, n);
+  c.jobSentMs = millis();
+}
+
+// ワーカーの結果を受け取って submit する
+static void io_on_result_(const DucoResultMsg& r) {
+  if (r.conn >= DUCO_IO_MAX_CONNS) return;
+  DucoConn& c = g_conns[r.conn];
+  // 結果が届く前に接続が切れていたら捨てる（そのジョブはもう submit できない）
+  if (r.connGen != c.gen || c.state != CONN_WORKING) return;
+
+  c.resultMs = millis();
+  g_hashes += r.hashes;   // ★追加: 通算（停めた / 答えが無かったジョブの分も回したうち）
+  c.job.thread     = r.worker;
+  c.job.hashes     = r.hashes;
+  c.job.compute_us = r.solve_us;
+  c.job.pause_us   = r.pause_us;
+  c.job.wall_us    = (uint32_t)(esp_timer_get_time() - c.jobQueuedUs);
+  c.trace.nonce    = (r.kind == DUCO_RES_FOUND) ? r.nonce : 0xFFFFFFFFu;
+  c.trace.hashes   = r.hashes;
+  c.trace.solve_us = r.solve_us;
+  c.trace.thread   = r.worker;
+  if (r.kind != DUCO_RES_FOUND) {
+    if (r.kind == DUCO_RES_NONE) {
+      char st[32];
+      snprintf(st, sizeof(st), "no share (C%u)", (unsigned)r.conn);
+      io_status_(st);
+    }
+    // DROP は解き終えていないのでトレースには書かない（記録には残す）
+    job_finish_(c, r.kind == DUCO_RES_NONE ? MINING_JOB_NONE : MINING_JOB_DROP);
+    c.state = CONN_READY;
+    return;
+  }
+
+  DucoIoIdent id;
+  io_ident_(id);
+  c.shares++;
+
+  // Submit: nonce,hashrate,banner ver,rig,DUCOID<chip>,<walletid>\n
+  char submit[DUCO_PROTO_TX_MAX];
+  const size_t n = duco_fmt_submit(submit, sizeof(submit), r.nonce, r.hps,
+                                   id.banner, id.version, id.rig, id.chip, id.walletid);
+  if (n) c.cli.write((const uint8_t*)submit, n);
+
+  // ★ 追加：送った内容（短く）をログ
+  mc_logf("[DUCO-C%u] submit nonce=%u hps=%.1f",
+          (unsigned)r.conn, (unsigned)r.nonce, r.hps);
+
+  c.state = CONN_WAIT_FB;
+  c.t0    = millis();
+
+  // ★追加: パイプライン -> GOOD / BAD を待たずに次の JOB も送っておく（返事は feedback → job の順）
+  if (g_pipeline && !c.drain && (int)r.conn < g_want) {
+    io_send_job_(c, r.conn);
+    c.jobPending = true;
+  }
+}
+
+// ★追加: connect は待たない。WiFiClient::connect(..., 3000) は I/O タスクごと止まり、
+// 他の接続の submit / feedback / 結果の受け取りまで最大 3 秒待たせていた。
+// ノンブロッキングのソケットで connect を始め、CONN_CONNECTING で繋がったかを見る
+static bool io_connect_start_(DucoConn& c) {
+  IPAddress ip;
+  // getPool / キャッシュのノードは IP。pool_nodes のホスト名だけは DNS を待つ（lwIP が覚えておく）
+  if (!ip.fromString(g_host) && !WiFi.hostByName(g_host, ip)) return false;
+  const int fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+  if (fd < 0) return false;
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+  // Nagle を切る（パイプラインで submit の直後に送る JOB を、submit の ACK 待ちで止めない）
+  const int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &one, sizeof(one));
+
+  sockaddr_in a;
+  memset(&a, 0, sizeof(a));
+  a.sin_family      = AF_INET;
+  a.sin_addr.s_addr = (uint32_t)ip;
+  a.sin_port        = htons(g_port);
+  if (connect(fd, (sockaddr*)&a, sizeof(a)) != 0 && errno != EINPROGRESS) {
+    close(fd);
+    return false;
+  }
+  c.connFd = fd;
+  return true;
+}
+
+// 繋がったら 1（ソケットは cli に渡す）、まだなら 0、失敗は -1
+static int io_connect_poll_(DucoConn& c) {
+  fd_set wfds;
+  FD_ZERO(&wfds);
+  FD_SET(c.connFd, &wfds);
+  timeval tv = {0, 0};
+  const int r = select(c.connFd + 1, nullptr, &wfds, nullptr, &tv);
+  if (r == 0) return 0;
+  int       err = 0;
+  socklen_t len = sizeof(err);
+  if (r < 0 || getsockopt(c.connFd, SOL_SOCKET, SO_ERROR, &err, &len) != 0 || err != 0) return -1;
+  // 繋がったらブロッキングに戻して WiFiClient に渡す
+  fcntl(c.connFd, F_SETFL, fcntl(c.connFd, F_GETFL, 0) & ~O_NONBLOCK);
+  c.cli    = WiFiClient(c.connFd);
+  c.connFd = -1;
+  return 1;
+}
+
+static void io_pool_fail_(const char* diag) {
+  io_diag_(diag);
+  if (g_hooks.pool_fail) g_hooks.pool_fail();
+}
+
+// 接続 k を1歩進める（待たない）
+static void io_step_(uint8_t k, int want) {
+  DucoConn& c = g_conns[k];
+  const unsigned long now = millis();
+  char st[80];
+
+  if (c.state != CONN_IDLE && c.state != CONN_CONNECTING &&
+      !c.cli.connected() && !c.cli.available()) {
+    mc_logf("[DUCO-C%u] connection closed by pool", (unsigned)k);
+    if (c.state == CONN_WAIT_FB) io_share_(c, false);
+    io_close_(c, 2000);
+    return;
+  }
+
+  switch (c.state) {
+    case CONN_IDLE:
+      if ((int)k >= want || (long)(now - c.retry_ms) < 0) return;
+      mc_logf("[DUCO-C%u] connect %s:%u ...", (unsigned)k, g_host, g_port);
+      c.connStartMs = millis();
+      c.connected   = false;
+      if (!io_connect_start_(c)) {
+        io_close_(c, 1000);
+        io_pool_fail_("Cannot connect to the pool node.");   // ★追加
+        return;
+      }
+      c.state = CONN_CONNECTING;
+      c.t0    = millis();
+      return;
+
+    case CONN_CONNECTING: {
+      const int r = io_connect_poll_(c);
+      if (r == 0 && now - c.t0 <= 3000) return;
+      if (r <= 0) {
+        mc_logf("[DUCO-C%u] connect %s", (unsigned)k, r < 0 ? "failed" : "timeout");
+        io_close_(c, 1000);
+        io_pool_fail_("Cannot connect to the pool node.");   // ★追加
+        return;
+      }
+      c.cli.setTimeout(15);
+      __atomic_add_fetch(&c.gen, 1, __ATOMIC_RELAXED);
+      c.rx.len  = 0;
+      c.state   = CONN_BANNER;
+      c.t0      = millis();
+      return;
+    }
+
+    case CONN_BANNER:
+      if (conn_read_line_(c)) {
+        const char* ver = "";
+        duco_parse_banner(c.rx.buf, &ver);
+        // ★ 追加：サーバーバージョンをログ
+        mc_logf("[DUCO-C%u] server version: %s", (unsigned)k, ver);
+        duco_lat_add(c.latConn, (uint32_t)(millis() - c.connStartMs));
+        io_diag_("");                          // ★ここで一旦「エラーなし」に
+        c.connected = true;
+        snprintf(st, sizeof(st), "connected (C%u) %s", (unsigned)k, g_name);
+        io_status_(st);
+        c.state     = CONN_READY;
+        if (g_hooks.pool_ok) g_hooks.pool_ok();
+      } else if (now - c.t0 > 5000) {
+        duco_lat_add(c.latConn, (uint32_t)(now - c.connStartMs));
+        io_close_(c, 2000);
+        io_pool_fail_("Pool node is not responding.");     // ★追加
+      }
+      return;
+
+    case CONN_READY:
+      if (c.drain) {   // ★追加: 前のノードの分は片付いた
+        mc_logf("[DUCO-C%u] drained", (unsigned)k);
+        io_close_(c, 0);
+        return;
+      }
+      if ((int)k >= want) return;   // 今はジョブを増やさない（接続は保つ）
+      io_send_job_(c, k);
+      c.state = CONN_WAIT_JOB;
+      c.t0    = c.jobSentMs;
+      return;
+
+    case CONN_WAIT_JOB:
+      if (conn_read_line_(c)) {
+        c.last_ping_ms = (float)(millis() - c.jobSentMs);
+        // ★ 追加：ping をログ
+        mc_logf("[DUCO-C%u] job ping = %.1f ms", (unsigned)k, c.last_ping_ms);
+        duco_lat_add(c.latJob, (uint32_t)c.last_ping_ms);
+
+        DucoJobMsg  job;
+        DucoJobLine jl;
+        job.conn    = k;
+        job.connGen = c.gen;
+        if (c.rx.overflow || !duco_parse_job(c.rx.buf, jl) || jl.prevLen >= sizeof(job.prev)) {
+          mc_logf("[DUCO-C%u] bad job line", (unsigned)k);
+          io_diag_("No job response from the pool.");
+          io_close_(c, 2000);
+          return;
+        }
+        memcpy(job.prev, jl.prev, jl.prevLen);
+        job.prev[jl.prevLen] = '\0';
+        job.prevLen    = (uint8_t)jl.prevLen;
+        memcpy(job.expected, jl.expected, sizeof(job.expected));
+        job.difficulty = jl.difficulty;
+        c.difficulty   = job.difficulty;
+
+        // ★追加: ジョブの記録を作り始める（残りは結果と feedback で埋める）
+        c.job            = MiningJobRecord();
+        c.job.conn       = k;
+        c.job.difficulty = jl.difficulty;
+        c.job.ping_ms    = (uint16_t)(c.last_ping_ms < 65535.0f ? c.last_ping_ms : 65535.0f);
+        c.jobValid       = true;
+        c.jobQueuedUs    = esp_timer_get_time();
+        // トレース中ならトレースのレコードも
+        c.traceValid = g_trace && duco_trace_set_prev(c.trace, jl.prev, jl.prevLen);
+        if (c.traceValid) {
+          memcpy(c.trace.expected, jl.expected, sizeof(c.trace.expected));
+          c.trace.difficulty = jl.difficulty;
+        }
+
+        // ★ 追加：ジョブの中身をログ
+        mc_logf("[DUCO-C%u] job diff=%u prev=%s", (unsigned)k,
+                (unsigned)job.difficulty, job.prev);
+
+        // キューは接続数ぶんあるので溢れない
+        xQueueSend(g_jobQ, &job, 0);
+        c.state = CONN_WORKING;
+
+        // ★追加: 前の結果から次のジョブを積むまで（直列: submit→GOOD→JOB の 2 往復、パイプライン: 1 往復）
+        float turn = -1.0f;
+        if (c.resultMs) {
+          c.last_turn_ms = (float)(millis() - c.resultMs);
+          c.resultMs = 0;
+          turn = c.last_turn_ms;
+          mc_logf("[DUCO-C%u] turnaround = %.1f ms", (unsigned)k, c.last_turn_ms);
+        }
+        if (g_hooks.job_queued) g_hooks.job_queued(c, turn);
+      } else if (now - c.jobSentMs > 10000) {
+        snprintf(st, sizeof(st), "no job (C%u)", (unsigned)k);
+        io_status_(st);
+        // ★ 追加：タイムアウトをログ
+        mc_logf("[DUCO-C%u] no job (timeout)", (unsigned)k);
+        duco_lat_add(c.latJob, (uint32_t)(now - c.jobSentMs));
+        io_diag_("No job response from the pool."); // ★追加
+        io_close_(c, 2000);
+      }
+      return;
+
+    case CONN_WORKING:
+      return;   // ワーカーの結果待ち（io_on_result_）
+
+    case CONN_WAIT_FB:
+      if (conn_read_line_(c)) {
+        c.last_fb_ms = (float)(millis() - c.t0);
+        // ★ 追加：フィードバックそのもの
+        mc_logf("[DUCO-C%u] feedback: '%s' (%.1f ms)", (unsigned)k, c.rx.buf, c.last_fb_ms);
+        duco_lat_add(c.latFb, (uint32_t)c.last_fb_ms);
+        // ★変更: BLOCK（ブロックを見つけた）も受理として数える
+        const DucoFeedback fb = duco_parse_feedback(c.rx.buf);
+        c.job.fb_ms = (uint16_t)(c.last_fb_ms < 65535.0f ? c.last_fb_ms : 65535.0f);
+        job_finish_(c, fb == DUCO_FB_GOOD    ? MINING_JOB_GOOD
+                       : fb == DUCO_FB_BLOCK ? MINING_JOB_BLOCK
+                                             : MINING_JOB_BAD);
+        const bool ok = duco_feedback_accepted(fb);
+        io_share_(c, ok);
+        snprintf(st, sizeof(st), "share %s (#%u, C%u)", ok ? "GOOD" : "BAD",
+                 (unsigned)c.shares, (unsigned)k);
+        io_status_(st);
+        if (ok) io_diag_("");     // ★正常
+        // BAD のときはとりあえず直ちにPoolエラー扱いにはしない
+
+        // ★追加: 前のノードへの接続なら、パイプラインの JOB の返事は待たずに閉じる
+        if (c.drain) {
+          mc_logf("[DUCO-C%u] drained", (unsigned)k);
+          io_close_(c, 0);
+          return;
+        }
+        // ★パイプライン: 続けて来る JOB の返事を待つ。もう届いていればそのままワーカーへ
+        c.state = c.jobPending ? CONN_WAIT_JOB : CONN_READY;
+        c.jobPending = false;
+        if (c.state == CONN_WAIT_JOB) {
+          c.t0 = c.jobSentMs;
+          io_step_(k, want);
+        }
+        return;
+      } else if (now - c.t0 > 10000) {
+        snprintf(st, sizeof(st), "no feedback (C%u)", (unsigned)k);
+        io_status_(st);
+        // ★ 追加：timeout も「失敗したシェア」として数える
+        io_share_(c, false);
+        mc_logf("[DUCO-C%u] no feedback (timeout)", (unsigned)k);
+        duco_lat_add(c.latFb, (uint32_t)(now - c.t0));
+        io_diag_("No result response from the pool."); // ★追加
+        io_close_(c, 2000);
+      }
+      return;
+  }
+}
+
+void duco_io_begin(const DucoIoHooks& hooks, int workers) {
+  g_hooks   = hooks;
+  g_workers = (workers < DUCO_IO_MAX_WORKERS) ? workers : DUCO_IO_MAX_WORKERS;
+  if (!g_jobQ) g_jobQ = xQueueCreate(DUCO_IO_MAX_CONNS, sizeof(DucoJobMsg));
+}
+
+void duco_io_set_task(TaskHandle_t io) {
+  g_ioTask = io;
+}
+
+void duco_io_set_pool(const char* host, uint16_t port, const char* name) {
+  strncpy(g_host, host ? host : "", sizeof(g_host) - 1);
+  strncpy(g_name, name ? name : "", sizeof(g_name) - 1);
+  g_port = port;
+}
+
+int duco_io_reconnect(bool drain) {
+  int draining = 0;
+  for (int k = 0; k < DUCO_IO_MAX_CONNS; ++k) {
+    DucoConn& c = g_conns[k];
+    if (c.state == CONN_IDLE) continue;
+    if (drain && (c.state == CONN_WORKING || c.state == CONN_WAIT_FB)) {
+      c.drain = true;
+      ++draining;
+    } else {
+      io_close_(c, 0);
+    }
+  }
+  return draining;
+}
+
+void duco_io_close_all() {
+  for (int k = 0; k < DUCO_IO_MAX_CONNS; ++k) {
+    if (g_conns[k].state != CONN_IDLE) io_close_(g_conns[k], 0);
+  }
+}
+
+void duco_io_results(int want) {
+  g_want = want;
+  DucoResultMsg r;
+  for (int i = 0; i < g_workers; ++i) {
+    while (result_pop_(g_results[i], r)) io_on_result_(r);
+  }
+}
+
+void duco_io_step_all(int want) {
+  g_want = want;
+  for (int k = 0; k < DUCO_IO_MAX_CONNS; ++k) io_step_((uint8_t)k, want);
+}
+
+const DucoConn& duco_io_conn(int k) {
+  return g_conns[k];
+}
+
+uint64_t duco_io_hashes() {
+  return g_hashes;
+}
+
+void duco_io_set_pipelined(bool on) {
+  g_pipeline = on;
+}
+
+bool duco_io_pipelined() {
+  return g_pipeline;
+}
+
+void duco_io_set_hps_compute(bool on) {
+  g_hpsCompute = on;
+}
+
+void duco_io_set_trace(bool on) {
+  g_trace = on;
+}
+
+// ---- ワーカー側 ----
+
+bool duco_io_job_take(DucoJobMsg& job, uint32_t timeoutMs) {
+  return g_jobQ && xQueueReceive(g_jobQ, &job, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+}
+
+void duco_io_job_return(const DucoJobMsg& job) {
+  xQueueSendToFront(g_jobQ, &job, 0);
+}
+
+static void io_rate_(int idx, float wall_kh, float compute_kh) {
+  if (g_hooks.rate) g_hooks.rate(idx, wall_kh, compute_kh);
+}
+
+void duco_io_run_job(int idx, DucoJobMsg& job) {
+  char tag[8];
+  snprintf(tag, sizeof(tag), "T%d", idx);
+
+  // 積まれた後に接続が切れていたら、そのジョブは submit できないので捨てる
+  if (conn_gen_(job.conn) != job.connGen) return;
+
+  if (job.parked_ms) {
+    if (millis() - job.parked_ms > MC_DUCO_PARK_MAX_MS) {
+      mc_logf("[DUCO-%s] parked job too old -> drop", tag);
+      DucoResultMsg r;
+      r.kind     = DUCO_RES_DROP;
+      r.conn     = job.conn;
+      r.connGen  = job.connGen;
+      r.worker   = (uint8_t)idx;
+      r.hashes   = job.hashes;
+      r.solve_us = job.compute_us;
+      r.pause_us = (job.paused_ms + (uint32_t)(millis() - job.parked_ms)) * 1000U;
+      result_post_(idx, r);
+      return;
+    }
+    const uint32_t parkedMs = (uint32_t)(millis() - job.parked_ms);
+    job.paused_ms += parkedMs;
+    mc_logf("[DUCO-%s] resume parked job diff=%u next=%u (parked %.1fs)",
+            tag, (unsigned)job.difficulty, (unsigned)job.next, parkedMs / 1000.0f);
+  }
+
+  // solve（★協調モードでは out.hashes = 全ワーカー合計、out.own = 自分の分）
+  DucoIoSolve out;
+  out.next = job.next;
+  unsigned long tStart = micros();
+  const uint32_t foundNonce =
+      g_hooks.solve ? g_hooks.solve(idx, job, &g_conns[job.conn].gen, out) : DUCO_S1_ABORTED;
+  const uint32_t runUs = (uint32_t)(micros() - tStart);
+  const uint32_t runComputeUs = (out.stall_us < runUs) ? runUs - out.stall_us : 0;
+  // 停めていた分も足す（停止中の時間は含めない）
+  const uint32_t hashes    = out.hashes + job.hashes;
+  const uint32_t elapsedUs = job.elapsed_us + runUs;
+  const uint32_t computeUs = job.compute_us + runComputeUs;
+
+  if (foundNonce == DUCO_S1_ABORTED) {
+    io_rate_(idx, 0.0f, 0.0f);
+    if (conn_gen_(job.conn) != job.connGen) {
+      mc_logf("[DUCO-%s] connection lost -> job dropped", tag);
+      return;
+    }
+    // ★変更: mining control requested to stop this thread -> 続きを他の（有効になった）ワーカーに
+    job.next       = out.next;
+    job.hashes     = hashes;
+    job.elapsed_us = elapsedUs;
+    job.compute_us = computeUs;
+    job.parked_ms  = millis();
+    xQueueSendToFront(g_jobQ, &job, 0);
+    mc_logf("[DUCO-%s] job parked next=%u/%u hashes=%u", tag,
+            (unsigned)out.next, (unsigned)(job.difficulty * 100U), (unsigned)hashes);
+    return;
+  }
+
+  float sec = elapsedUs / 1000000.0f;
+  if (sec <= 0) sec = 0.001f;
+  float csec = computeUs / 1000000.0f;
+  if (csec <= 0) csec = 0.001f;
+  const float hpsWall    = hashes / sec;
+  const float hpsCompute = hashes / csec;
+  // ★変更: submit に載せる値は方針で選ぶ（MC_DUCO_HASHRATE_POLICY）
+  const float hps = g_hpsCompute ? hpsCompute : hpsWall;
+
+  // ★ 追加：solver の実績をログ（★変更: 計算時間の方も）
+  mc_logf("[DUCO-%s] solved nonce=%u hashes=%u time=%.3fs (%.1f H/s) compute=%.3fs (%.1f H/s)",
+          tag, (unsigned)foundNonce, (unsigned)hashes, sec, hpsWall, csec, hpsCompute);
+
+  DucoResultMsg r;
+  r.conn     = job.conn;
+  r.connGen  = job.connGen;
+  r.hps      = hps;
+  r.worker   = (uint8_t)idx;
+  r.hashes   = hashes;
+  r.solve_us = computeUs;
+  r.pause_us = job.paused_ms * 1000U;
+  if (foundNonce == DUCO_S1_NOT_FOUND) {
+    r.kind = DUCO_RES_NONE;
+  } else {
+    // スレッドごとのハッシュレートは自分が回した分だけ（合計は updateMiningSummary で足す）
+    const float runSec = (runUs > 0) ? runUs / 1000000.0f : 0.001f;
+    const float runCSec = (runComputeUs > 0) ? runComputeUs / 1000000.0f : 0.001f;
+    io_rate_(idx, (out.own / runSec) / 1000.0f, (out.own / runCSec) / 1000.0f);
+    r.kind  = DUCO_RES_FOUND;
+    r.nonce = foundNonce;
+  }
+  result_post_(idx, r);
+}
@@ -0,0 +1,189 @@
+// src/duco_io.h
+#pragma once
+// ===== プール I/O（全接続）↔ 計算ワーカー =====
+// mining_task の I/O タスクとワーカーの間（接続の状態遷移・JOB / submit / feedback・ジョブキュー・結果リング）。
+// ネットワークは I/O タスク 1 本が全接続をまとめて扱う。
+//   I/O タスク : 接続 / banner / JOB 要求 / submit / GOOD・BAD をノンブロッキングで回し
+//                （duco_io_results → duco_io_step_all）、受け取ったジョブをキューに積む
+//   ワーカー   : duco_io_job_take でジョブを取って duco_io_run_job で解くだけ（ソケットには触らない）。
+//                結果はワーカーごとの SPSC リング（ロックなし）で I/O タスクに返す
+// ジョブは接続に紐づく（submit はそのジョブをくれた接続に送る）が、どのワーカーが解いてもよい。
+// 解いている間に次のジョブが待っているように、接続は「取り出す側の数 + MC_DUCO_IO_SPARE_JOBS」本まで張る。
+//
+// 状態（g_status / 診断 / 受理数 / ジョブの記録 / トレース）と解き方（duco_solve_duco_s1）は
+// mining_task 側にあり、DucoIoHooks で呼ぶ。
+// ※ 使うのは WiFiClient / lwIP のソケット / FreeRTOS のキューと通知だけ。ホストでは
+//    test/duco-mockpool/shim の置き換えで組み、duco-mockpool がこのコードをそのまま回す
+#include <Arduino.h>
+#include <WiFi.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "config.h"
+#include "mining_task.h"
+#include "duco_proto.h"
+#include "duco_latency_hist.h"
+#include "duco_trace.h"
+
+static const uint8_t DUCO_IO_MAX_WORKERS = MC_MINER_MAX_THREADS;
+static const uint8_t DUCO_IO_MAX_CONNS   = MC_MINER_MAX_THREADS + MC_DUCO_IO_SPARE_JOBS;
+
+// I/O タスク → ワーカー（ジョブキュー）
+// ★止められたジョブ（スレッドが disable された）は進み具合を書き足してキューの先頭に戻し、
+// 有効なワーカーが続きから回す。ジョブはその接続に紐づくので、接続が切れたら捨てる。
+struct DucoJobMsg {
+  uint8_t       conn         = 0;
+  uint32_t      connGen      = 0;   // 積んだときの接続の世代
+  char          prev[81]     = {0};
+  uint8_t       prevLen      = 0;
+  unsigned char expected[20] = {0};
+  uint32_t      difficulty   = 1;
+  uint32_t      next         = 0;   // 次に試す nonce
+  uint32_t      hashes       = 0;   // 停めるまでに回した数（全ワーカー合計）
+  uint32_t      elapsed_us   = 0;   // 停めるまでの計算時間（停止中は含めない）
+  unsigned long parked_ms    = 0;   // 停めた時刻（0 = 停めていない）
+  uint32_t      paused_ms    = 0;   // ★追加: 停めていた時間の合計（再開のたびに足す）
+  uint32_t      compute_us   = 0;   // ★追加: 停めるまでの計算時間（elapsed_us から yield / 一時停止を除いた分）
+};
+
+// ワーカー → I/O タスク（結果リング）
+enum DucoResultKind : uint8_t {
+  DUCO_RES_FOUND = 0,   // nonce を submit する
+  DUCO_RES_NONE,        // 範囲内に無かった
+  DUCO_RES_DROP,        // 停めたまま古くなった -> 次の JOB をもらう
+};
+
+struct DucoResultMsg {
+  uint8_t  kind    = DUCO_RES_NONE;
+  uint8_t  conn    = 0;
+  uint32_t connGen = 0;
+  uint32_t nonce   = 0;
+  float    hps     = 0.0f;      // submit に載せるハッシュレート（停めていた分も含む）
+  // ★追加: トレース用（duco_trace）
+  uint8_t  worker   = 0;
+  uint32_t hashes   = 0;        // 回した数（停めていた分も含む）
+  uint32_t solve_us = 0;        // 解いていた計算時間（停めていた間・yield / 一時停止は含まない）
+  uint32_t pause_us = 0;        // ★追加: 停めていた時間（ジョブ記録用）
+};
+
+enum DucoConnState : uint8_t {
+  CONN_IDLE = 0,   // ソケットなし（retry_ms まで再接続しない）
+  CONN_CONNECTING, // ★追加: ノンブロッキングの connect の完了待ち（connFd）
+  CONN_BANNER,     // 接続直後、サーバーのバージョン行待ち
+  CONN_READY,      // ジョブを持っていない
+  CONN_WAIT_JOB,   // JOB を送って返事待ち
+  CONN_WORKING,    // ジョブをワーカーに渡した
+  CONN_WAIT_FB,    // submit を送って GOOD / BAD 待ち（jobPending なら続けて JOB の返事も来る）
+};
+
+// プール接続ひとつ（I/O タスクだけが触る。gen と統計は他のタスクからも読む）
+struct DucoConn {
+  WiFiClient    cli;
+  DucoConnState state    = CONN_IDLE;
+  uint32_t      gen      = 0;   // 開く / 閉じるたびに +1（ワーカーはこれが変わったら打ち切る）
+  unsigned long t0       = 0;   // 今の状態に入った時刻（タイムアウト用）
+  unsigned long retry_ms = 0;   // CONN_IDLE: この時刻までは再接続しない
+  // ★追加: パイプライン（submit の直後に JOB も送る）。返事は送った順に来る
+  bool          jobPending = false;   // WAIT_FB の後に JOB の返事が続く
+  unsigned long jobSentMs  = 0;       // JOB を送った時刻（ping）
+  unsigned long resultMs   = 0;       // ワーカーの結果を受け取った時刻（次のジョブまでの turnaround）
+  DucoLineBuf   rx;             // ★変更: 受信中の1行（固定長。揃ったら rx.buf をその場で解析）
+  int           connFd   = -1;  // ★追加: CONN_CONNECTING の間だけのソケット（繋がったら cli に渡す）
+  bool          drain    = false;   // ★追加: 前のノードへの接続。今のジョブ / feedback を片付けたら閉じる
+
+  // 統計（updateMiningSummary で合計）
+  bool     connected    = false;
+  uint32_t shares       = 0;
+  uint32_t difficulty   = 0;
+  uint32_t accepted     = 0;
+  uint32_t rejected     = 0;
+  float    last_ping_ms = 0.0f;   // JOB を送ってからジョブが届くまで
+  float    last_fb_ms   = 0.0f;   // ★追加: submit を送ってから GOOD / BAD が届くまで
+  float    last_turn_ms = 0.0f;   // ★追加: 結果を受け取ってから次のジョブをキューに積むまで（ワーカーが待たされうる時間）
+  // ★追加: 遅れの分布（起動から。タイムアウトはその時点までの時間で入れる）
+  DucoLatHist   latJob;               // JOB を送ってからジョブが届くまで
+  DucoLatHist   latFb;                // submit から GOOD / BAD まで
+  DucoLatHist   latConn;              // connect を始めてから banner が届くまで
+  unsigned long connStartMs = 0;
+
+  // ★追加: 今のジョブの記録（feedback まで揃ったら hooks.record、トレース中なら hooks.trace にも）
+  MiningJobRecord job;
+  bool            jobValid   = false;
+  int64_t         jobQueuedUs = 0;    // ジョブをキューに積んだ時刻（wall_us の起点）
+  DucoTraceRecord trace;
+  bool            traceValid = false;
+};
+
+// JOB / submit に載せる名前（SET で変わるので送るたびに hooks.ident で取り直す）
+struct DucoIoIdent {
+  const char* user     = "";
+  const char* key      = "";
+  const char* banner   = "";
+  const char* version  = "";
+  const char* rig      = "";
+  const char* chip     = "";
+  uint32_t    walletid = 0;
+};
+
+// hooks.solve の結果（duco_solve_duco_s1 の出力と同じ）
+struct DucoIoSolve {
+  uint32_t hashes   = 0;   // 全ワーカー合計（協調モード）
+  uint32_t own      = 0;   // このワーカーが回した分
+  uint32_t next     = 0;   // DUCO_S1_ABORTED のとき、次に試す nonce
+  uint32_t stall_us = 0;   // yield / 一時停止で止まっていた時間
+};
+
+// mining_task（ホストでは duco-mockpool）が持つ側。使わないものは nullptr でよい
+struct DucoIoHooks {
+  // ---- I/O タスクから ----
+  void (*status)(const char* text)  = nullptr;   // 状態の 1 行（g_status）
+  void (*diag)(const char* text)    = nullptr;   // UI 向けのプールの診断（"" = エラーなし）
+  void (*ident)(DucoIoIdent& out)   = nullptr;
+  void (*pool_ok)()                 = nullptr;   // 今のノードの banner が届いた
+  void (*pool_fail)()               = nullptr;   // 今のノードへの connect / banner が失敗した
+  // feedback（切断 / タイムアウトは不受理）。c.drain なら前のノードの分
+  void (*share)(const DucoConn& c, bool accepted) = nullptr;
+  // ジョブをキューに積んだ。turn_ms は前の結果からここまで（前の結果が無ければ負）
+  void (*job_queued)(const DucoConn& c, float turn_ms) = nullptr;
+  void (*record)(const MiningJobRecord& r)  = nullptr;   // ジョブの記録が閉じた
+  void (*trace)(const DucoTraceRecord& r)   = nullptr;   // duco_io_set_trace(true) の間だけ
+  // ---- ワーカーから ----
+  // job を job.next から解く。connGen が job.connGen から変わったら打ち切る。
+  // 戻り値は nonce / DUCO_S1_NOT_FOUND / DUCO_S1_ABORTED
+  uint32_t (*solve)(int idx, const DucoJobMsg& job, const uint32_t* connGen,
+                    DucoIoSolve& out) = nullptr;
+  // ワーカーのハッシュレート（見つけたら自分が回した分 / 打ち切ったら 0）
+  void (*rate)(int idx, float wall_kh, float compute_kh) = nullptr;
+};
+
+// ジョブキューを作る（I/O タスクとワーカーを起こす前に 1 回）。workers は結果リングを見る本数
+void duco_io_begin(const DucoIoHooks& hooks, int workers);
+// ワーカーが結果を返したら起こすタスク（I/O タスクの頭で自分を渡す）
+void duco_io_set_task(TaskHandle_t io);
+
+// ---- I/O タスク ----
+// 繋ぐノード（切り替えても今の接続はそのまま。duco_io_reconnect で閉じる）
+void duco_io_set_pool(const char* host, uint16_t port, const char* name);
+// 全接続を閉じて今のノードへ繋ぎ直す。drain なら解きかけ / feedback 待ちの接続は片付くまで残す
+// （もう JOB は送らない）。戻り値は残した本数
+int  duco_io_reconnect(bool drain);
+void duco_io_close_all();
+// ワーカーの結果を受け取って submit する（submit は早いほどいいので先に）
+void duco_io_results(int want);
+// 全接続を 1 歩ずつ進める（待たない）。want = 張っておく本数（= 同時に持つジョブの数）
+void duco_io_step_all(int want);
+const DucoConn& duco_io_conn(int k);
+uint64_t duco_io_hashes();   // 結果で受け取った回した数の合計（停めた / 答えが無かったジョブも）
+
+// submit + JOB をまとめて送る / submit に計算時間で割ったハッシュレートを載せる / トレースのレコードを作る
+void duco_io_set_pipelined(bool on);
+bool duco_io_pipelined();
+void duco_io_set_hps_compute(bool on);
+void duco_io_set_trace(bool on);
+
+// ---- ワーカー ----
+bool duco_io_job_take(DucoJobMsg& job, uint32_t timeoutMs);
+void duco_io_job_return(const DucoJobMsg& job);   // 取ったが回せない -> 他のワーカーに（先頭へ）
+// ジョブ1つを解いて結果を返す。disable で止められたらキューの先頭に戻す
+void duco_io_run_job(int idx, DucoJobMsg& job);
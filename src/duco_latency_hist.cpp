@@ -0,0 +1,58 @@
+// src/duco_latency_hist.cpp
+#include "duco_latency_hist.h"
+
+#include <string.h>
+
+size_t duco_lat_bucket(uint32_t ms) {
+  if (ms > DUCO_LAT_MAX_MS) ms = DUCO_LAT_MAX_MS;
+  if (ms < 4) return ms;
+  const int e = 31 - __builtin_clz(ms);   // 2..15
+  return (size_t)((e - 1) * 4 + ((ms >> (e - 2)) & 3));
+}
+
+uint32_t duco_lat_bucket_lo(size_t i) {
+  if (i < 4) return (uint32_t)i;
+  const int e = (int)(i / 4) + 1;
+  return (uint32_t)(4 + i % 4) << (e - 2);
+}
+
+uint32_t duco_lat_bucket_hi(size_t i) {
+  return (i + 1 < DUCO_LAT_BUCKETS) ? duco_lat_bucket_lo(i + 1) : DUCO_LAT_MAX_MS + 1;
+}
+
+void duco_lat_add(DucoLatHist& h, uint32_t ms) {
+  ++h.n[duco_lat_bucket(ms)];
+  ++h.count;
+  if (ms > h.max_ms) h.max_ms = ms;
+}
+
+void duco_lat_merge(DucoLatHist& dst, const DucoLatHist& src) {
+  for (size_t i = 0; i < DUCO_LAT_BUCKETS; ++i) dst.n[i] += src.n[i];
+  dst.count += src.count;
+  if (src.max_ms > dst.max_ms) dst.max_ms = src.max_ms;
+}
+
+void duco_lat_clear(DucoLatHist& h) {
+  memset(h.n, 0, sizeof(h.n));
+  h.count  = 0;
+  h.max_ms = 0;
+}
+
+float duco_lat_quantile(const DucoLatHist& h, float q) {
+  if (!h.count) return -1.0f;
+  if (q < 0.0f) q = 0.0f;
+  if (q > 1.0f) q = 1.0f;
+  // 小さい方から数えて rank 番目（1 始まり）が入っているバケツ
+  uint32_t rank = (uint32_t)(q * (float)h.count + 0.999f);
+  if (rank < 1) rank = 1;
+  uint32_t seen = 0;
+  for (size_t i = 0; i < DUCO_LAT_BUCKETS; ++i) {
+    seen += h.n[i];
+    if (seen < rank) continue;
+    const uint32_t lo = duco_lat_bucket_lo(i), hi = duco_lat_bucket_hi(i);
+    float v = (hi - lo <= 1) ? (float)lo : 0.5f * (float)(lo + hi - 1);
+    if (v > (float)h.max_ms) v = (float)h.max_ms;
+    return v;
+  }
+  return (float)h.max_ms;
+}
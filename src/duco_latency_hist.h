@@ -0,0 +1,31 @@
+// src/duco_latency_hist.h
+#pragma once
+// 遅れ [ms] の対数ヒストグラム（固定長。確保なし）
+//
+// 0..3 ms は 1 ms 刻み、そこから先は 2 のべきごとに 4 等分（相対誤差 12.5 % 以下）。
+// 65535 ms より上は最後のバケツにまとめる。足すのは O(1)、合算はバケツごとの足し算なので
+// 接続ごとに持っておき、読む側（updateMiningSummary）でまとめてから p50 / p95 / p99 を出す。
+// ※ Arduino に依存しない（ホスト側でもそのままビルドできる）こと。
+
+#include <stddef.h>
+#include <stdint.h>
+
+static const size_t   DUCO_LAT_BUCKETS = 60;
+static const uint32_t DUCO_LAT_MAX_MS  = 65535;
+
+struct DucoLatHist {
+  uint32_t n[DUCO_LAT_BUCKETS] = {0};
+  uint32_t count  = 0;
+  uint32_t max_ms = 0;
+};
+
+size_t   duco_lat_bucket(uint32_t ms);
+// バケツ i が受け持つ範囲 [lo, hi)
+uint32_t duco_lat_bucket_lo(size_t i);
+uint32_t duco_lat_bucket_hi(size_t i);
+
+void  duco_lat_add(DucoLatHist& h, uint32_t ms);
+void  duco_lat_merge(DucoLatHist& dst, const DucoLatHist& src);
+void  duco_lat_clear(DucoLatHist& h);
+// q (0..1) の分位点 [ms]。入っているバケツの中央（最大値は超えない）。空なら -1
+float duco_lat_quantile(const DucoLatHist& h, float q);
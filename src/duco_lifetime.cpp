@@ -0,0 +1,73 @@
+// src/duco_lifetime.cpp
+#include "duco_lifetime.h"
+
+static inline void put_u32_(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static inline uint32_t get_u32_(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+uint32_t duco_life_crc32(const uint8_t* p, size_t len) {
+  // 表を持たないビットごとの版（40 バイトを数分に 1 回なので十分）
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= p[i];
+    for (int k = 0; k < 8; ++k) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+  }
+  return ~crc;
+}
+
+void duco_life_encode(const DucoLifeRecord& r, uint8_t out[DUCO_LIFE_REC_SIZE]) {
+  put_u32_(out, DUCO_LIFE_MAGIC);
+  put_u32_(out + 4, r.seq);
+  put_u32_(out + 8, r.boots);
+  put_u32_(out + 12, r.accepted);
+  put_u32_(out + 16, r.rejected);
+  put_u32_(out + 20, r.uptime_s);
+  put_u32_(out + 24, r.mining_s);
+  put_u32_(out + 28, (uint32_t)r.hashes);
+  put_u32_(out + 32, (uint32_t)(r.hashes >> 32));
+  put_u32_(out + 36, duco_life_crc32(out, 36));
+}
+
+bool duco_life_decode(const uint8_t in[DUCO_LIFE_REC_SIZE], DucoLifeRecord& r) {
+  if (get_u32_(in) != DUCO_LIFE_MAGIC) return false;
+  if (get_u32_(in + 36) != duco_life_crc32(in, 36)) return false;
+  r.seq      = get_u32_(in + 4);
+  r.boots    = get_u32_(in + 8);
+  r.accepted = get_u32_(in + 12);
+  r.rejected = get_u32_(in + 16);
+  r.uptime_s = get_u32_(in + 20);
+  r.mining_s = get_u32_(in + 24);
+  r.hashes   = (uint64_t)get_u32_(in + 28) | ((uint64_t)get_u32_(in + 32) << 32);
+  return true;
+}
+
+int duco_life_pick(const uint8_t* file, size_t len, DucoLifeRecord& out) {
+  int best = -1;
+  DucoLifeRecord bestRec;
+  for (size_t i = 0; i < DUCO_LIFE_SLOTS && file && (i + 1) * DUCO_LIFE_REC_SIZE <= len; ++i) {
+    DucoLifeRecord r;
+    if (!duco_life_decode(file + i * DUCO_LIFE_REC_SIZE, r)) continue;
+    // seq は一周しても差の符号で比べる
+    if (best < 0 || (int32_t)(r.seq - bestRec.seq) > 0) {
+      best    = (int)i;
+      bestRec = r;
+    }
+  }
+  if (best >= 0) out = bestRec;
+  return best;
+}
+
+bool duco_life_flush_due(const DucoLifeRecord& now, const DucoLifeRecord& written,
+                         uint32_t elapsedMs, uint32_t intervalMs, uint32_t shares) {
+  const uint32_t dShares = (now.accepted - written.accepted) + (now.rejected - written.rejected);
+  if (shares && dShares >= shares) return true;
+  if (!intervalMs || elapsedMs < intervalMs) return false;
+  return dShares != 0 || now.hashes != written.hashes || now.uptime_s != written.uptime_s;
+}
@@ -0,0 +1,51 @@
+// src/duco_lifetime.h
+#pragma once
+// 起動をまたいで数えるマイニングの通算カウンタ（受理 / 却下 / ハッシュ数 / 稼働時間）
+//
+// LittleFS には固定長スロット DUCO_LIFE_SLOTS 個の 1 ファイルを置き、
+// 書くたびに次のスロットへ（seq を +1 して）上書きする（同じ場所ばかり書かない）。
+// 起動時はファイルを 1 回読んで、CRC が合うスロットのうち seq が一番新しいものを使う
+// （スロット数は固定なので読み込みは O(1)。書きかけで電源が落ちても 1 つ前が残る）。
+// 書くのはシェアごとではなく、時間か増分がしきい値を超えたときだけ（duco_life_flush_due）。
+//
+// スロット: magic seq boots accepted rejected uptime_s mining_s（各 u32）hashes(u64) crc32(u32)
+//           ※数値はすべてリトルエンディアン。crc32 は先頭から hashes までの IEEE CRC-32
+// ※ Arduino に依存しない（ホスト側でもそのままビルドできる）こと。
+
+#include <stddef.h>
+#include <stdint.h>
+
+static const size_t   DUCO_LIFE_REC_SIZE  = 40;
+static const size_t   DUCO_LIFE_SLOTS     = 8;
+static const size_t   DUCO_LIFE_FILE_SIZE = DUCO_LIFE_REC_SIZE * DUCO_LIFE_SLOTS;
+static const uint32_t DUCO_LIFE_MAGIC     = 0x3146494Cu;   // "LIF1"
+
+struct DucoLifeRecord {
+  uint32_t seq      = 0;   // 書いた回数（新しいスロットほど大きい）
+  uint32_t boots    = 0;   // 起動回数
+  uint32_t accepted = 0;
+  uint32_t rejected = 0;
+  uint32_t uptime_s = 0;   // 電源が入っていた時間の合計
+  uint32_t mining_s = 0;   // そのうちワーカーがハッシュを回していた時間（一時停止中 / 全スレッド無効は除く）
+  uint64_t hashes   = 0;
+};
+
+uint32_t duco_life_crc32(const uint8_t* p, size_t len);
+
+void duco_life_encode(const DucoLifeRecord& r, uint8_t out[DUCO_LIFE_REC_SIZE]);
+// magic と CRC が合うときだけ true
+bool duco_life_decode(const uint8_t in[DUCO_LIFE_REC_SIZE], DucoLifeRecord& r);
+
+// ファイルの中身（len は足りなくてもよい）から一番新しいスロットを探す。
+// 見つかれば out に入れてそのスロット番号、無ければ -1（out はそのまま）
+int duco_life_pick(const uint8_t* file, size_t len, DucoLifeRecord& out);
+// 次に書くスロット（pick の戻り値の次。-1 なら 0）
+static inline size_t duco_life_next_slot(int picked) {
+  return (picked < 0) ? 0 : ((size_t)picked + 1) % DUCO_LIFE_SLOTS;
+}
+
+// 前に書いてからの増分で、今書くべきか。
+//   elapsedMs >= intervalMs で何か増えていれば / 受理 + 却下の増分 >= shares なら true
+//   （intervalMs / shares が 0 ならその条件は使わない）
+bool duco_life_flush_due(const DucoLifeRecord& now, const DucoLifeRecord& written,
+                         uint32_t elapsedMs, uint32_t intervalMs, uint32_t shares);
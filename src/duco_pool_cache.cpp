@@ -0,0 +1,77 @@
+// src/duco_pool_cache.cpp
+#include "duco_pool_cache.h"
+
+#include <ArduinoJson.h>
+#include <FS.h>
+#include <LittleFS.h>
+#include <time.h>
+
+#include "logging.h"
+
+static const char* kPoolCachePath = "/duco_pool.json";
+
+// 2020-01-01 より前は「まだ NTP で合っていない」
+static const uint32_t kClockValidAfter = 1577836800UL;
+
+uint32_t duco_pool_now_s() {
+  const time_t now = time(nullptr);
+  return ((uint32_t)now >= kClockValidAfter) ? (uint32_t)now : 0;
+}
+
+bool duco_pool_cache_expired(const DucoPoolEntry& e, uint32_t maxAgeS) {
+  const uint32_t now = duco_pool_now_s();
+  if (!now || e.fetched_at < kClockValidAfter) return true;
+  if (now < e.fetched_at) return false;   // 時計が戻った：新しいものとして扱う
+  return now - e.fetched_at > maxAgeS;
+}
+
+static void copy_field_(char* dst, size_t cap, const char* src) {
+  strncpy(dst, src ? src : "", cap - 1);
+  dst[cap - 1] = '\0';
+}
+
+bool duco_pool_cache_load(DucoPoolEntry& out) {
+  if (!LittleFS.begin(true)) return false;
+  if (!LittleFS.exists(kPoolCachePath)) return false;
+
+  File f = LittleFS.open(kPoolCachePath, "r");
+  if (!f) return false;
+
+  JsonDocument doc;
+  DeserializationError err = deserializeJson(doc, f);
+  f.close();
+  if (err) {
+    mc_logf("[POOL] cache parse failed: %s", err.c_str());
+    return false;
+  }
+
+  DucoPoolEntry e;
+  copy_field_(e.name, sizeof(e.name), doc["name"] | "");
+  copy_field_(e.host, sizeof(e.host), doc["ip"] | "");
+  e.port       = (uint16_t)(doc["port"] | 0);
+  e.fetched_at = doc["fetched_at"] | 0u;
+  if (!duco_pool_entry_valid(e)) return false;
+
+  out = e;
+  return true;
+}
+
+bool duco_pool_cache_save(const DucoPoolEntry& e) {
+  if (!duco_pool_entry_valid(e)) return false;
+  if (!LittleFS.begin(true)) return false;
+
+  JsonDocument doc;
+  doc["name"]       = e.name;
+  doc["ip"]         = e.host;
+  doc["port"]       = e.port;
+  doc["fetched_at"] = e.fetched_at;
+
+  File f = LittleFS.open(kPoolCachePath, "w");
+  if (!f) {
+    mc_logf("[POOL] cache open failed: %s", kPoolCachePath);
+    return false;
+  }
+  serializeJson(doc, f);
+  f.close();
+  return true;
+}
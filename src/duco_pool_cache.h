@@ -0,0 +1,30 @@
+// src/duco_pool_cache.h
+#pragma once
+// 最後に使えたプールノード（getPool の結果）を LittleFS に覚えておく。
+// 起動時はこれで先に繋ぎ、getPool（HTTPS）の結果は裏で待つ（mining_task.cpp）。
+#include <Arduino.h>
+
+struct DucoPoolEntry {
+  char     name[40]   = {0};   // getPool の name
+  char     host[64]   = {0};   // ip
+  uint16_t port       = 0;
+  uint32_t fetched_at = 0;     // getPool で取った時刻（UNIX 秒。時計が合っていなければ 0）
+};
+
+static inline bool duco_pool_entry_valid(const DucoPoolEntry& e) {
+  return e.port != 0 && e.host[0] != '\0';
+}
+
+static inline bool duco_pool_entry_same_node(const DucoPoolEntry& a, const DucoPoolEntry& b) {
+  return a.port == b.port && strcmp(a.host, b.host) == 0;
+}
+
+// 無い / 壊れている / 中身が足りないときは false
+bool duco_pool_cache_load(DucoPoolEntry& out);
+bool duco_pool_cache_save(const DucoPoolEntry& e);
+
+// 取った時刻から maxAgeS を過ぎたか。今の時刻か fetched_at が分からなければ「過ぎた」扱い
+bool duco_pool_cache_expired(const DucoPoolEntry& e, uint32_t maxAgeS);
+
+// 今の UNIX 秒（NTP で合う前は 0）
+uint32_t duco_pool_now_s();
@@ -0,0 +1,169 @@
+// src/duco_pool_select.cpp
+#include "duco_pool_select.h"
+
+#include <string.h>
+
+static void copy_field_(char* dst, size_t cap, const char* src) {
+  strncpy(dst, src ? src : "", cap - 1);
+  dst[cap - 1] = '\0';
+}
+
+int duco_pool_sel_find(const DucoPoolSel& sel, const char* host, uint16_t port) {
+  if (!host) return -1;
+  for (int i = 0; i < sel.n; ++i) {
+    if (sel.c[i].port == port && strcmp(sel.c[i].host, host) == 0) return i;
+  }
+  return -1;
+}
+
+int duco_pool_sel_add(DucoPoolSel& sel, const char* host, uint16_t port,
+                      const char* name, DucoPoolOrigin origin, int keep) {
+  if (!host || !*host || port == 0 || strlen(host) >= sizeof(sel.c[0].host)) return -1;
+
+  int i = duco_pool_sel_find(sel, host, port);
+  if (i >= 0) {
+    if (name && *name) copy_field_(sel.c[i].name, sizeof(sel.c[i].name), name);
+    if (origin == DUCO_POOL_FROM_USER) sel.c[i].origin = DUCO_POOL_FROM_USER;
+    return i;
+  }
+
+  if (sel.n < DUCO_POOL_MAX_CANDS) {
+    i = sel.n++;
+  } else {
+    float worst = -1.0f;
+    for (int k = 0; k < sel.n; ++k) {
+      if (k == keep || sel.c[k].origin == DUCO_POOL_FROM_USER) continue;
+      const float s = duco_pool_sel_score(sel.c[k]);
+      if (s > worst) { worst = s; i = k; }
+    }
+    if (i < 0) return -1;
+  }
+
+  DucoPoolCand& c = sel.c[i];
+  c = DucoPoolCand();
+  copy_field_(c.name, sizeof(c.name), name && *name ? name : host);
+  copy_field_(c.host, sizeof(c.host), host);
+  c.port   = port;
+  c.origin = origin;
+  return i;
+}
+
+static inline float ewma_(float cur, float v) {
+  return (cur < 0.0f) ? v : cur + DUCO_POOL_EWMA_ALPHA * (v - cur);
+}
+
+void duco_pool_sel_probe(DucoPoolSel& sel, int i, bool ok, float connect_ms, float banner_ms) {
+  if (i < 0 || i >= sel.n) return;
+  DucoPoolCand& c = sel.c[i];
+  c.probes++;
+  if (!ok) {
+    c.probe_fails++;
+    if (c.fail_streak < 255) c.fail_streak++;
+    return;
+  }
+  c.fail_streak = 0;
+  c.connect_ms  = ewma_(c.connect_ms, connect_ms < 0.0f ? 0.0f : connect_ms);
+  c.banner_ms   = ewma_(c.banner_ms, banner_ms < 0.0f ? 0.0f : banner_ms);
+}
+
+void duco_pool_sel_share(DucoPoolSel& sel, int i, bool accepted) {
+  if (i < 0 || i >= sel.n) return;
+  if (accepted) sel.c[i].accepted++;
+  else          sel.c[i].rejected++;
+}
+
+float duco_pool_sel_score(const DucoPoolCand& c) {
+  if (c.connect_ms < 0.0f || c.fail_streak >= DUCO_POOL_FAIL_DROP) return DUCO_POOL_SCORE_NONE;
+  // 1 回だけ測れなかったものは少し悪く見せる
+  const float lat = (c.connect_ms + c.banner_ms) * (1.0f + 0.5f * (float)c.fail_streak);
+  const float rej = (float)c.rejected /
+                    (float)(c.accepted + c.rejected + DUCO_POOL_REJ_PRIOR);
+  return lat / (1.0f - rej);
+}
+
+int duco_pool_sel_best(const DucoPoolSel& sel, int exclude) {
+  int   best  = -1;
+  float bestS = DUCO_POOL_SCORE_NONE;
+  for (int i = 0; i < sel.n; ++i) {
+    if (i == exclude) continue;
+    const float s = duco_pool_sel_score(sel.c[i]);
+    if (s < bestS) { bestS = s; best = i; }
+  }
+  return best;
+}
+
+int duco_pool_sel_pick(const DucoPoolSel& sel, int cur, float margin, float minGapMs) {
+  const int best = duco_pool_sel_best(sel, cur);
+  if (best < 0) return -1;
+  if (cur < 0 || cur >= sel.n) return best;
+
+  const float sc = duco_pool_sel_score(sel.c[cur]);
+  if (sc >= DUCO_POOL_SCORE_NONE) return best;
+  const float sb = duco_pool_sel_score(sel.c[best]);
+  if (sb < sc * (1.0f - margin) && sc - sb >= minGapMs) return best;
+  return -1;
+}
+
+// "host:port" 1 つ（[p, end)。前後の空白は許す）
+static bool parse_node_(const char* p, const char* end, char* host, size_t hostCap, uint16_t& port) {
+  while (p < end && *p == ' ') ++p;
+  while (end > p && end[-1] == ' ') --end;
+
+  const char* colon = nullptr;
+  for (const char* q = p; q < end; ++q) {
+    if (*q == ':') { colon = q; break; }
+  }
+  if (!colon || colon == p || (size_t)(colon - p) >= hostCap) return false;
+  for (const char* q = p; q < colon; ++q) {
+    const char ch = *q;
+    const bool ok = (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') ||
+                    (ch >= '0' && ch <= '9') || ch == '.' || ch == '-' || ch == '_';
+    if (!ok) return false;
+  }
+
+  uint32_t v = 0;
+  const char* q = colon + 1;
+  if (q == end) return false;
+  for (; q < end; ++q) {
+    if (*q < '0' || *q > '9') return false;
+    v = v * 10 + (uint32_t)(*q - '0');
+    if (v > 65535) return false;
+  }
+  if (v == 0) return false;
+
+  memcpy(host, p, (size_t)(colon - p));
+  host[colon - p] = '\0';
+  port = (uint16_t)v;
+  return true;
+}
+
+int duco_pool_parse_nodes(const char* s, DucoPoolSel* sel) {
+  if (!s) return 0;
+
+  // 空白だけなら 0 個
+  const char* t = s;
+  while (*t == ' ') ++t;
+  if (!*t) return 0;
+
+  char     host[sizeof(((DucoPoolCand*)0)->host)];
+  uint16_t port = 0;
+
+  // 1 周目で書式を確かめ、2 周目で足す
+  for (int pass = 0; pass < 2; ++pass) {
+    int n = 0;
+    const char* p = s;
+    for (;;) {
+      const char* e = strchr(p, ',');
+      if (!e) e = p + strlen(p);
+      if (!parse_node_(p, e, host, sizeof(host), port)) return -1;
+      if (pass == 1 && sel) duco_pool_sel_add(*sel, host, port, nullptr, DUCO_POOL_FROM_USER);
+      ++n;
+      if (!*e) {
+        if (pass == 1 || !sel) return n;
+        break;
+      }
+      p = e + 1;
+    }
+  }
+  return -1;
+}
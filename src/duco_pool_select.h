@@ -0,0 +1,74 @@
+// src/duco_pool_select.h
+#pragma once
+// プールノードの候補表と順位付け（確保なし）
+//
+// 候補 = getPool の結果 + 設定の pool_nodes + 前回のキャッシュ（duco_pool_cache）。
+// DucoPool タスクが各候補の TCP connect と banner が届くまでの時間を裏で測り、
+// I/O タスクが今のノードで受けた accept / reject を足していく（どちらも mining_task.cpp）。
+// スコアは「1 シェア受理あたりの往復の重さ」の目安で、小さいほど良い：
+//
+//   score = (connect_ms + banner_ms) / (1 - reject 率)
+//
+// reject 率は受理 DUCO_POOL_REJ_PRIOR 回ぶんを最初から足して均す（数シェアで振れないように）。
+// ※ Arduino に依存しない（ホスト側でもそのままビルドできる）こと。
+
+#include <stddef.h>
+#include <stdint.h>
+
+static const int   DUCO_POOL_MAX_CANDS  = 6;
+static const float DUCO_POOL_SCORE_NONE = 1e9f;   // 未計測 / 繋がらない
+static const float DUCO_POOL_EWMA_ALPHA = 0.3f;   // 測るたびに新しい値をこの割合で混ぜる
+static const int   DUCO_POOL_REJ_PRIOR  = 8;
+static const int   DUCO_POOL_FAIL_DROP  = 2;      // 続けてこの回数測れなければ候補から外す（表には残す）
+
+enum DucoPoolOrigin : uint8_t {
+  DUCO_POOL_FROM_GETPOOL = 0,
+  DUCO_POOL_FROM_USER,    // 設定の pool_nodes（表が一杯でも追い出さない）
+  DUCO_POOL_FROM_CACHE,
+};
+
+struct DucoPoolCand {
+  char     name[40]    = {0};
+  char     host[64]    = {0};
+  uint16_t port        = 0;
+  uint8_t  origin      = DUCO_POOL_FROM_GETPOOL;
+  uint8_t  fail_streak = 0;     // 続けて測れなかった数
+  float    connect_ms  = -1.0f; // EWMA（< 0 = まだ）
+  float    banner_ms   = -1.0f;
+  uint32_t probes      = 0;
+  uint32_t probe_fails = 0;
+  uint32_t accepted    = 0;     // このノードで掘っている間のシェア
+  uint32_t rejected    = 0;
+};
+
+struct DucoPoolSel {
+  DucoPoolCand c[DUCO_POOL_MAX_CANDS];
+  int          n = 0;
+};
+
+// host:port の候補の番号（無ければ -1）
+int duco_pool_sel_find(const DucoPoolSel& sel, const char* host, uint16_t port);
+
+// 候補を足す（既にあれば name を更新してその番号）。一杯なら keep 以外の USER でない候補のうち
+// 一番スコアの悪いものと入れ替える。入れられなければ -1
+int duco_pool_sel_add(DucoPoolSel& sel, const char* host, uint16_t port,
+                      const char* name, DucoPoolOrigin origin, int keep = -1);
+
+// 1 回測った結果（ok = banner まで届いた）
+void duco_pool_sel_probe(DucoPoolSel& sel, int i, bool ok, float connect_ms, float banner_ms);
+
+// 今のノードで受けた feedback
+void duco_pool_sel_share(DucoPoolSel& sel, int i, bool accepted);
+
+float duco_pool_sel_score(const DucoPoolCand& c);
+
+// 一番スコアの良い使える候補（exclude は除く）。無ければ -1
+int duco_pool_sel_best(const DucoPoolSel& sel, int exclude = -1);
+
+// 乗り換え先（乗り換えないなら -1）。今の候補 cur が使えなければ一番良いものへ。
+// 使えるなら、best が cur より margin（割合）かつ minGapMs 以上良いときだけ（行ったり来たりしない）
+int duco_pool_sel_pick(const DucoPoolSel& sel, int cur, float margin, float minGapMs);
+
+// 設定の pool_nodes："host:port" をカンマで並べたもの（空 = なし）。
+// sel があれば USER として足す。戻り値は個数、書式が違えば -1（sel は触らない）
+int duco_pool_parse_nodes(const char* s, DucoPoolSel* sel);
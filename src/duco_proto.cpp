@@ -0,0 +1,221 @@
+// src/duco_proto.cpp
+#include "duco_proto.h"
+
+#include <string.h>
+
+// ---------- 受信 ----------
+
+bool duco_line_push(DucoLineBuf& lb, char ch, size_t* lineLen) {
+  if (ch == '\n') {
+    size_t n = lb.len;
+    while (n && (lb.buf[n - 1] == '\r' || lb.buf[n - 1] == ' ')) --n;
+    lb.buf[n] = '\0';
+    if (lineLen) *lineLen = n;
+    lb.len = 0;
+    return true;
+  }
+  if (lb.len == 0) lb.overflow = false;   // 新しい行
+  if (lb.len < DUCO_PROTO_LINE_MAX - 1) {
+    lb.buf[lb.len++] = ch;
+  } else {
+    lb.overflow = true;
+  }
+  return false;
+}
+
+static inline char* skip_spaces_(char* p) {
+  while (*p == ' ' || *p == '\t' || *p == '\r') ++p;
+  return p;
+}
+
+// [p, end) の末尾の空白を '\0' で切る
+static inline void rtrim_(char* p, char* end) {
+  while (end > p && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) --end;
+  *end = '\0';
+}
+
+static inline int hex_nibble_(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+bool duco_parse_banner(char* line, const char** version) {
+  if (!line) return false;
+  char* p = skip_spaces_(line);
+  rtrim_(p, p + strlen(p));
+  if (!*p) return false;
+  if (version) *version = p;
+  return true;
+}
+
+bool duco_parse_job(char* line, DucoJobLine& out) {
+  if (!line) return false;
+
+  char* c1 = strchr(line, ',');
+  if (!c1) return false;
+  char* c2 = strchr(c1 + 1, ',');
+  if (!c2) return false;
+
+  // prev
+  char* prev = skip_spaces_(line);
+  rtrim_(prev, c1);
+  const size_t plen = strlen(prev);
+  if (plen == 0) return false;
+
+  // expected（40 桁 hex）
+  char* exp = skip_spaces_(c1 + 1);
+  rtrim_(exp, c2);
+  if (strlen(exp) != 40) return false;
+  for (int i = 0; i < 20; ++i) {
+    const int hi = hex_nibble_(exp[i * 2]);
+    const int lo = hex_nibble_(exp[i * 2 + 1]);
+    if (hi < 0 || lo < 0) return false;
+    out.expected[i] = (uint8_t)((hi << 4) | lo);
+  }
+
+  // difficulty（10 進。後ろの空白は許す）
+  const char* d = skip_spaces_(c2 + 1);
+  if (*d < '0' || *d > '9') return false;
+  uint64_t v = 0;
+  while (*d >= '0' && *d <= '9') {
+    v = v * 10 + (uint64_t)(*d - '0');
+    if (v > UINT32_MAX) return false;
+    ++d;
+  }
+  d = skip_spaces_((char*)d);
+  if (*d) return false;
+
+  out.prev       = prev;
+  out.prevLen    = plen;
+  out.difficulty = v ? (uint32_t)v : 1;
+  return true;
+}
+
+DucoFeedback duco_parse_feedback(char* line, const char** reason) {
+  if (reason) *reason = "";
+  if (!line) return DUCO_FB_UNKNOWN;
+  char* p = skip_spaces_(line);
+  rtrim_(p, p + strlen(p));
+
+  if (strcmp(p, "GOOD") == 0)  return DUCO_FB_GOOD;
+  if (strcmp(p, "BLOCK") == 0) return DUCO_FB_BLOCK;
+  if (strncmp(p, "BAD", 3) == 0 && (p[3] == '\0' || p[3] == ',')) {
+    if (reason && p[3] == ',') *reason = p + 4;
+    return DUCO_FB_BAD;
+  }
+  return DUCO_FB_UNKNOWN;
+}
+
+// ---------- 送信 ----------
+
+size_t duco_fmt_u32(char* dst, uint32_t v) {
+  char tmp[10];
+  size_t n = 0;
+  do {
+    tmp[n++] = (char)('0' + v % 10);
+    v /= 10;
+  } while (v);
+  for (size_t i = 0; i < n; ++i) dst[i] = tmp[n - 1 - i];
+  return n;
+}
+
+size_t duco_fmt_fixed2(char* dst, float v) {
+  if (!(v > 0.0f)) v = 0.0f;   // 負 / NaN
+  // 100 倍して四捨五入（H/s は 4e9 を超えないが、念のため 64bit で）
+  const double scaled = (double)v * 100.0 + 0.5;
+  uint64_t c = (scaled < 1.8e19) ? (uint64_t)scaled : UINT64_C(18000000000000000000);
+  const uint64_t ip = c / 100;
+  const uint32_t fp = (uint32_t)(c % 100);
+
+  char tmp[20];
+  size_t n = 0;
+  uint64_t x = ip;
+  do {
+    tmp[n++] = (char)('0' + x % 10);
+    x /= 10;
+  } while (x);
+  size_t o = 0;
+  while (n) dst[o++] = tmp[--n];
+  dst[o++] = '.';
+  dst[o++] = (char)('0' + fp / 10);
+  dst[o++] = (char)('0' + fp % 10);
+  return o;
+}
+
+namespace {
+// 固定長バッファへの追記（溢れたら ok = false のまま以降は何もしない）
+struct Writer {
+  char*  dst;
+  size_t cap;
+  size_t len = 0;
+  bool   ok  = true;
+
+  Writer(char* d, size_t c) : dst(d), cap(c) {}
+
+  void str(const char* s) {
+    if (!s) s = "";
+    const size_t n = strlen(s);
+    if (!ok || len + n >= cap) { ok = false; return; }
+    memcpy(dst + len, s, n);
+    len += n;
+  }
+  void ch(char c) {
+    if (!ok || len + 1 >= cap) { ok = false; return; }
+    dst[len++] = c;
+  }
+  void u32(uint32_t v) {
+    if (!ok || len + 10 >= cap) { ok = false; return; }
+    len += duco_fmt_u32(dst + len, v);
+  }
+  void fixed2(float v) {
+    if (!ok || len + 24 >= cap) { ok = false; return; }
+    len += duco_fmt_fixed2(dst + len, v);
+  }
+  size_t finish() {
+    if (!ok) {
+      if (cap) dst[0] = '\0';
+      return 0;
+    }
+    dst[len] = '\0';
+    return len;
+  }
+};
+}  // namespace
+
+size_t duco_fmt_job_request(char* dst, size_t cap,
+                            const char* user, const char* board, const char* key) {
+  Writer w(dst, cap);
+  w.str("JOB,");
+  w.str(user);
+  w.ch(',');
+  w.str(board);
+  w.ch(',');
+  w.str(key);
+  w.ch('\n');
+  return w.finish();
+}
+
+size_t duco_fmt_submit(char* dst, size_t cap,
+                       uint32_t nonce, float hps,
+                       const char* banner, const char* version,
+                       const char* rig, const char* chipId,
+                       uint32_t walletId) {
+  Writer w(dst, cap);
+  w.u32(nonce);
+  w.ch(',');
+  w.fixed2(hps);
+  w.ch(',');
+  w.str(banner);
+  w.ch(' ');
+  w.str(version);
+  w.ch(',');
+  w.str(rig);
+  w.str(",DUCOID");
+  w.str(chipId);
+  w.ch(',');
+  w.u32(walletId);
+  w.ch('\n');
+  return w.finish();
+}
@@ -0,0 +1,78 @@
+// src/duco_proto.h
+#pragma once
+// Duino-Coin プール TCP プロトコルのコーデック（確保なし・snprintf なし）
+//
+//   サーバー → banner       : "3.0\n"
+//   miner   → JOB          : "JOB,<user>,<board>,<key>\n"
+//   サーバー → job          : "<prev>,<expected 40桁hex>,<difficulty>\n"
+//   miner   → submit       : "<nonce>,<hashrate>,<banner> <ver>,<rig>,DUCOID<chip>,<walletid>\n"
+//   サーバー → feedback     : "GOOD\n" / "BLOCK\n" / "BAD,<理由>\n"
+//
+// 受信は固定長の行バッファに溜め、行の中身はその場で（コピーせずに）切り分ける。
+// 送信は呼び出し側の固定長バッファに書く。String / ヒープ / printf 系は使わない。
+// ※ Arduino に依存しない（ホスト側でもそのままビルドできる）こと。
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 受信する1行の最大長（終端込み）。これを超えた分は捨てて overflow を立てる
+static const size_t DUCO_PROTO_LINE_MAX = 128;
+// 送信する1行の最大長（終端込み）。submit の rig 名などが長いとき用に余裕を持たせる
+static const size_t DUCO_PROTO_TX_MAX   = 192;
+
+// ---------- 受信：1バイトずつ溜めて行にする ----------
+struct DucoLineBuf {
+  char   buf[DUCO_PROTO_LINE_MAX];
+  size_t len      = 0;
+  bool   overflow = false;   // 今の（揃った）行が長すぎて後ろを捨てた
+};
+
+// ch を1つ足す。'\n' で行が揃ったら true を返し、lb.buf は '\0' 終端・末尾の '\r' / 空白なし
+// （次の呼び出しで新しい行を溜め始める）。長さは *lineLen（任意）に
+bool duco_line_push(DucoLineBuf& lb, char ch, size_t* lineLen = nullptr);
+
+// ---------- 受信：行の解析（line はその場で書き換える） ----------
+
+// banner（サーバーのバージョン）。前後の空白を落として version に指す
+bool duco_parse_banner(char* line, const char** version);
+
+// job 行。prev は line の中を指す（'\0' 終端）。expected は 40 桁 hex のときだけ受け付ける。
+// difficulty は 10 進（0 は 1 に丸める）
+struct DucoJobLine {
+  const char* prev       = nullptr;
+  size_t      prevLen    = 0;
+  uint8_t     expected[20];
+  uint32_t    difficulty = 0;
+};
+bool duco_parse_job(char* line, DucoJobLine& out);
+
+enum DucoFeedback : uint8_t {
+  DUCO_FB_GOOD = 0,   // 受理
+  DUCO_FB_BLOCK,      // 受理（ブロックを見つけた）
+  DUCO_FB_BAD,        // 却下（reason に理由）
+  DUCO_FB_UNKNOWN,    // それ以外の行
+};
+// reason（任意）は "BAD," の後ろ（無ければ ""）
+DucoFeedback duco_parse_feedback(char* line, const char** reason = nullptr);
+
+static inline bool duco_feedback_accepted(DucoFeedback fb) {
+  return fb == DUCO_FB_GOOD || fb == DUCO_FB_BLOCK;
+}
+
+// ---------- 送信：行の組み立て（戻り値は書いた長さ。入りきらなければ 0） ----------
+
+// v を10進で dst に（終端なし）。戻り値は桁数（最大 10）
+size_t duco_fmt_u32(char* dst, uint32_t v);
+
+// v を小数点以下 2 桁の固定小数で dst に（終端なし・四捨五入・負は 0）。
+// Arduino の String(float) と同じ見た目。戻り値は長さ
+size_t duco_fmt_fixed2(char* dst, float v);
+
+size_t duco_fmt_job_request(char* dst, size_t cap,
+                            const char* user, const char* board, const char* key);
+
+size_t duco_fmt_submit(char* dst, size_t cap,
+                       uint32_t nonce, float hps,
+                       const char* banner, const char* version,
+                       const char* rig, const char* chipId,
+                       uint32_t walletId);
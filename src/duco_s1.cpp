@@ -0,0 +1,252 @@
+// src/duco_s1.cpp
+#include "duco_s1.h"
+#include "duco_s1_internal.h"
+
+#include <string.h>
+
+// ---------- SHA1 primitives ----------
+#define S1_F1(b, c, d) ((d) ^ ((b) & ((c) ^ (d))))
+#define S1_F2(b, c, d) ((b) ^ (c) ^ (d))
+#define S1_F3(b, c, d) (((b) & (c)) | ((d) & ((b) | (c))))
+#define S1_F4(b, c, d) ((b) ^ (c) ^ (d))
+
+// 1ラウンド分（変数の役割はマクロ呼び出し側でローテーションさせる）
+#define S1_R(a, b, c, d, e, F, K, wv)                  \
+  do {                                                 \
+    (e) += S1_ROTL((a), 5) + F((b), (c), (d)) + (K) + (wv); \
+    (b) = S1_ROTL((b), 30);                            \
+  } while (0)
+
+// W[t] (t>=16) を 16 ワードの循環バッファ上で展開
+#define S1_W(t) \
+  (W[(t) & 15] = S1_ROTL(W[((t) - 3) & 15] ^ W[((t) - 8) & 15] ^ \
+                         W[((t) - 14) & 15] ^ W[(t) & 15], 1))
+
+// 5ラウンドで変数の役割が一周する
+#define S1_R5(t, F, K, WX)                 \
+  S1_R(a, b, c, d, e, F, K, WX((t) + 0));  \
+  S1_R(e, a, b, c, d, F, K, WX((t) + 1));  \
+  S1_R(d, e, a, b, c, F, K, WX((t) + 2));  \
+  S1_R(c, d, e, a, b, F, K, WX((t) + 3));  \
+  S1_R(b, c, d, e, a, F, K, WX((t) + 4))
+
+// t は定数なので分岐はコンパイル時に畳まれる
+//   t<16 はそのまま W[t]、W16/W17 は前計算値（循環バッファの W0/W1 に上書き）
+#define S1_WX(t)                           \
+  ((t) < 16    ? W[(t) & 15]             \
+   : (t) == 16 ? (W[0] = job.w16)        \
+   : (t) == 17 ? (W[1] = job.w17)        \
+               : S1_W(t))
+
+#define S1_WD(t) W[(t)]
+
+// 役割を固定した1ラウンド（ラウンド 10..19 用。途中状態を保存できるように a..e を毎回ずらす）
+#define S1_RN(F, K, wv)                                          \
+  do {                                                           \
+    const uint32_t t_ = S1_ROTL(a, 5) + F(b, c, d) + e + (K) + (wv); \
+    e = d;                                                       \
+    d = c;                                                       \
+    c = S1_ROTL(b, 30);                                          \
+    b = a;                                                       \
+    a = t_;                                                      \
+  } while (0)
+
+#define S1_SAVE(i)       \
+  do {                   \
+    msg.st[i][0] = a;    \
+    msg.st[i][1] = b;    \
+    msg.st[i][2] = c;    \
+    msg.st[i][3] = d;    \
+    msg.st[i][4] = e;    \
+  } while (0)
+
+bool duco_s1_prepare(DucoS1Job& job, const char* seed, size_t seedLen) {
+  if (!seed || seedLen != DUCO_S1_SEED_LEN) return false;
+
+  uint32_t W[16];
+  for (int i = 0; i < 10; ++i) {
+    W[i] = load_be32((const uint8_t*)seed + i * 4);
+    job.w[i] = W[i];
+  }
+
+  // ラウンド 0..9 は seed だけで決まる
+  uint32_t a = S1_H0, b = S1_H1, c = S1_H2, d = S1_H3, e = S1_H4;
+  S1_R5(0, S1_F1, S1_K1, S1_WD);
+  S1_R5(5, S1_F1, S1_K1, S1_WD);
+
+  // W16 = rotl1(W13 ^ W8 ^ W2 ^ W0), W17 = rotl1(W14 ^ W9 ^ W3 ^ W1)
+  // W13/W14 は常に 0 なので seed だけで決まる
+  job.w16 = S1_ROTL(W[8] ^ W[2] ^ W[0], 1);
+  job.w17 = S1_ROTL(W[9] ^ W[3] ^ W[1], 1);
+
+  job.s10[0] = a;
+  job.s10[1] = b;
+  job.s10[2] = c;
+  job.s10[3] = d;
+  job.s10[4] = e;
+  return true;
+}
+
+void duco_s1_set_target(DucoS1Job& job, const uint8_t expected[20]) {
+  // digest = IV + 最終状態 なので、比較は IV を引いた内部状態で行う
+  job.tgt[0] = load_be32(expected + 0)  - S1_H0;
+  job.tgt[1] = load_be32(expected + 4)  - S1_H1;
+  job.tgt[2] = load_be32(expected + 8)  - S1_H2;
+  job.tgt[3] = load_be32(expected + 12) - S1_H3;
+  job.tgt[4] = load_be32(expected + 16) - S1_H4;
+  // 最終 e = rotl30(a76) → a76 = rotl2(最終 e)
+  job.tgt_a76 = S1_ROTL(job.tgt[4], 2);
+}
+
+void duco_s1_job_seed(const DucoS1Job& job, char seed[DUCO_S1_SEED_LEN]) {
+  for (int i = 0; i < 10; ++i) store_be32((uint8_t*)seed + i * 4, job.w[i]);
+}
+
+void duco_s1_job_expected(const DucoS1Job& job, uint8_t expected[20]) {
+  store_be32(expected + 0,  S1_H0 + job.tgt[0]);
+  store_be32(expected + 4,  S1_H1 + job.tgt[1]);
+  store_be32(expected + 8,  S1_H2 + job.tgt[2]);
+  store_be32(expected + 12, S1_H3 + job.tgt[3]);
+  store_be32(expected + 16, S1_H4 + job.tgt[4]);
+}
+
+// ラウンド 10..79 の本体。kReject=true のときはラウンド 75 の後で
+// H4 に相当するワードだけを target と比べ、外れなら残りを回さずに false を返す。
+// 最後まで回した場合は st[5] = a..e（IV 加算前）を書いて true。
+template <bool kReject>
+static inline bool s1_tail(const DucoS1Job& job, DucoS1Msg& msg,
+                           const char* digits, size_t digitsLen, size_t changed,
+                           uint32_t st[5]) {
+  if (digitsLen > 10) digitsLen = 10;
+
+  // ---- 変わったワードだけ詰め直す ----
+  size_t first;  // 最初に変化したワード（10..12）
+  if (digitsLen != msg.len) {
+    // 初回 or 桁数が変わった：パディング位置とビット長も変わるので全部
+    memcpy(msg.w, job.w, sizeof(job.w));
+    msg.w[13] = 0;
+    msg.w[14] = 0;
+    msg.w[15] = (uint32_t)((DUCO_S1_SEED_LEN + digitsLen) * 8);
+    memcpy(msg.st[0], job.s10, sizeof(job.s10));
+    msg.len = digitsLen;
+    first = 10;
+    for (size_t wi = 10; wi <= 12; ++wi) {
+      msg.w[wi] = pack_tail_word(digits, digitsLen, wi);
+    }
+  } else {
+    if (changed >= digitsLen) changed = digitsLen - 1;
+    first = (DUCO_S1_SEED_LEN + changed) / 4;
+    const size_t last = (DUCO_S1_SEED_LEN + digitsLen - 1) / 4;  // 最後の桁を含むワード
+    for (size_t wi = first; wi <= last; ++wi) {
+      msg.w[wi] = pack_tail_word(digits, digitsLen, wi);
+    }
+  }
+
+  uint32_t W[16];
+  memcpy(W, msg.w, sizeof(W));
+
+  // ---- ラウンド 10..15: 変化したワードの手前までは前回の状態を再利用 ----
+  uint32_t a = msg.st[first - 10][0], b = msg.st[first - 10][1],
+           c = msg.st[first - 10][2], d = msg.st[first - 10][3],
+           e = msg.st[first - 10][4];
+
+  switch (first) {
+    case 10: S1_RN(S1_F1, S1_K1, W[10]); S1_SAVE(1);  // fallthrough
+    case 11: S1_RN(S1_F1, S1_K1, W[11]); S1_SAVE(2);  // fallthrough
+    default: S1_RN(S1_F1, S1_K1, W[12]);               // case 12
+  }
+  // W13..W15 は桁数が同じ限り不変だが、直前の状態が変わるので回すだけ
+  S1_RN(S1_F1, S1_K1, W[13]);
+  S1_RN(S1_F1, S1_K1, W[14]);
+  S1_RN(S1_F1, S1_K1, W[15]);
+  S1_RN(S1_F1, S1_K1, S1_WX(16));
+  S1_RN(S1_F1, S1_K1, S1_WX(17));
+  S1_RN(S1_F1, S1_K1, S1_WX(18));
+  S1_RN(S1_F1, S1_K1, S1_WX(19));
+
+  S1_R5(20, S1_F2, S1_K2, S1_WX);
+  S1_R5(25, S1_F2, S1_K2, S1_WX);
+  S1_R5(30, S1_F2, S1_K2, S1_WX);
+  S1_R5(35, S1_F2, S1_K2, S1_WX);
+  S1_R5(40, S1_F3, S1_K3, S1_WX);
+  S1_R5(45, S1_F3, S1_K3, S1_WX);
+  S1_R5(50, S1_F3, S1_K3, S1_WX);
+  S1_R5(55, S1_F3, S1_K3, S1_WX);
+  S1_R5(60, S1_F4, S1_K4, S1_WX);
+  S1_R5(65, S1_F4, S1_K4, S1_WX);
+  S1_R5(70, S1_F4, S1_K4, S1_WX);
+
+  // 最終 e = rotl30(ラウンド 75 の出力) なので、ここで 1 ワードだけ比べられる
+  S1_R(a, b, c, d, e, S1_F4, S1_K4, S1_WX(75));
+  if (kReject && e != job.tgt_a76) return false;
+  S1_R(e, a, b, c, d, S1_F4, S1_K4, S1_WX(76));
+  S1_R(d, e, a, b, c, S1_F4, S1_K4, S1_WX(77));
+  S1_R(c, d, e, a, b, S1_F4, S1_K4, S1_WX(78));
+  S1_R(b, c, d, e, a, S1_F4, S1_K4, S1_WX(79));
+
+  st[0] = a;
+  st[1] = b;
+  st[2] = c;
+  st[3] = d;
+  st[4] = e;
+  return true;
+}
+
+void duco_s1_hash(const DucoS1Job& job, DucoS1Msg& msg,
+                  const char* digits, size_t digitsLen, size_t changed,
+                  uint8_t out[20]) {
+  uint32_t st[5];
+  s1_tail<false>(job, msg, digits, digitsLen, changed, st);
+
+  store_be32(out + 0,  S1_H0 + st[0]);
+  store_be32(out + 4,  S1_H1 + st[1]);
+  store_be32(out + 8,  S1_H2 + st[2]);
+  store_be32(out + 12, S1_H3 + st[3]);
+  store_be32(out + 16, S1_H4 + st[4]);
+}
+
+bool duco_s1_match(const DucoS1Job& job, DucoS1Msg& msg,
+                   const char* digits, size_t digitsLen, size_t changed) {
+  uint32_t st[5];
+  if (!s1_tail<true>(job, msg, digits, digitsLen, changed, st)) return false;
+
+  // ほぼ来ない：残り 4 ワードも含めて完全一致を確認
+  return st[0] == job.tgt[0] && st[1] == job.tgt[1] &&
+         st[2] == job.tgt[2] && st[3] == job.tgt[3] &&
+         st[4] == job.tgt[4];
+}
+
+
+void duco_s1_hash(const DucoS1Job& job,
+                  const char* digits, size_t digitsLen,
+                  uint8_t out[20]) {
+  DucoS1Msg msg;
+  duco_s1_hash(job, msg, digits, digitsLen, 0, out);
+}
+
+uint32_t duco_s1_scan(const DucoS1Job& job, uint32_t first, uint32_t last,
+                      uint32_t& hashes, DucoS1Control& ctl) {
+  hashes = 0;
+  if (first > last) return DUCO_S1_NOT_FOUND;
+
+  DucoS1Msg msg;
+  char   digits[12];
+  size_t len     = (size_t)duco_s1_u32_to_dec(digits, first);
+  size_t changed = 0;
+
+  uint32_t untilPoll = ctl.every;
+  for (uint32_t nonce = first;; ++nonce) {
+    const bool hit = duco_s1_match(job, msg, digits, len, changed);
+    hashes++;
+    if (hit) return nonce;
+
+    if (--untilPoll == 0) {
+      if (ctl.poll && !ctl.poll(ctl, nonce)) return DUCO_S1_ABORTED;
+      untilPoll = ctl.every ? ctl.every : 1;
+    }
+    if (nonce == last) break;
+
+    changed = duco_s1_nonce_inc(digits, len);
+  }
+  return DUCO_S1_NOT_FOUND;
+}
@@ -0,0 +1,166 @@
+// src/duco_s1.h
+#pragma once
+// DUCO-S1 専用 SHA1 カーネル
+//   hash = SHA1(seed(40桁hex) + decimal(nonce))
+//
+// seed は常に 40 文字なので、メッセージは 64 バイトの 1 ブロックに収まる。
+//   W0..W9   : seed（ジョブ中は不変）
+//   W10..W12 : nonce の10進数字 + 0x80 パディング
+//   W13,W14  : 常に 0 / W15 : ビット長（桁数が変わった時だけ変化）
+// W0..W9 しか使わないラウンド 0..9 と、W16/W17（seed と 0 だけで決まる）は
+// ジョブごとに1回だけ前計算し、nonce ごとにはラウンド 10..79 だけを回す。
+//
+// ※ Arduino に依存しない（ホスト側でもそのままビルドできる）こと。
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 高速パスが扱える seed 長（DUCO の prev は 40 桁 hex 固定）
+static const size_t DUCO_S1_SEED_LEN = 40;
+
+// ジョブごとの前計算結果（solver 1回につき1つ）
+struct DucoS1Job {
+  uint32_t w[10];     // W0..W9（seed を big-endian で詰めたもの）
+  uint32_t w16, w17;  // seed だけで決まる schedule ワード
+  uint32_t s10[5];    // ラウンド 0..9 を終えた時点の a,b,c,d,e
+  uint32_t tgt[5];    // expected から IV を引いた最終状態（duco_s1_set_target）
+  uint32_t tgt_a76;   // 早期棄却用：ラウンド 75 の出力がこの値でなければ不一致
+};
+
+// nonce ごとに使い回す作業領域（solver / スレッドごとに1つ）
+// 前回から変わっていないワードと、その手前までのラウンド状態をキャッシュする。
+struct DucoS1Msg {
+  uint32_t w[16];      // W0..W15 の最新値
+  uint32_t st[3][5];   // st[i] = ラウンド (10+i) 直前の a,b,c,d,e（nonce は W10..W12 のみ）
+  size_t   len = 0;    // 直前に詰めた桁数（0 = 未初期化）
+};
+
+// seed から前計算する。seedLen != DUCO_S1_SEED_LEN なら false（呼び出し側で汎用パスへ）
+bool duco_s1_prepare(DucoS1Job& job, const char* seed, size_t seedLen);
+
+// expected(20バイト) をカーネル内部の状態に合わせた target に変換しておく（ジョブごとに1回）
+void duco_s1_set_target(DucoS1Job& job, const uint8_t expected[20]);
+
+// job から seed（40 文字・終端なし）/ expected(20バイト) を復元する。
+// DucoS1Job しか受け取らない約束で汎用 SHA1（mbedTLS など）を走らせる用
+void duco_s1_job_seed(const DucoS1Job& job, char seed[DUCO_S1_SEED_LEN]);
+void duco_s1_job_expected(const DucoS1Job& job, uint8_t expected[20]);
+
+// SHA1(seed + digits) を out[20] に書く。digits は nonce の10進 ASCII（1..10 桁）
+void duco_s1_hash(const DucoS1Job& job,
+                  const char* digits, size_t digitsLen,
+                  uint8_t out[20]);
+
+// 上と同じだが、digits[changed..] だけが前回呼び出しから変わったことを前提に
+// 影響するワード / ラウンドだけを計算し直す（changed=0 なら全部）。
+// 桁数が前回と違う場合は changed に関係なく全部やり直す。
+void duco_s1_hash(const DucoS1Job& job, DucoS1Msg& msg,
+                  const char* digits, size_t digitsLen, size_t changed,
+                  uint8_t out[20]);
+
+// SHA1(seed + digits) == expected か（duco_s1_set_target 済みであること）。
+// ほとんどの候補はラウンド 75 の直後に 32bit 1ワードの比較で落とし、
+// 残り 4 ラウンドと digest の組み立ては一致しそうな候補でしか行わない。
+bool duco_s1_match(const DucoS1Job& job, DucoS1Msg& msg,
+                   const char* digits, size_t digitsLen, size_t changed);
+
+// ---------- nonce 範囲の走査（全カーネル共通の約束） ----------
+// 戻り値は duco_solve_duco_s1 と同じ：見つかった nonce / NOT_FOUND / ABORTED
+static const uint32_t DUCO_S1_NOT_FOUND = UINT32_MAX;
+static const uint32_t DUCO_S1_ABORTED   = UINT32_MAX - 1;
+
+// 走査中の制御ポイント（yield / 中断 / 演出用スナップショットは呼び出し側の仕事）
+// every 個ハッシュするごとに poll(ctl, 最後に試した nonce) が呼ばれ、false なら中断。
+// poll の中で ctl.every を書き換えると次の区切りから反映される。
+struct DucoS1Control {
+  uint32_t every = 1024;
+  bool   (*poll)(DucoS1Control& ctl, uint32_t nonce) = nullptr;
+  void*    user  = nullptr;
+};
+
+// [first, last] を順に試す（duco_s1_set_target 済みであること）。hashes に試した数
+// 1 本ずつ・オドメータ + ラウンド状態キャッシュ + 早期棄却
+uint32_t duco_s1_scan(const DucoS1Job& job, uint32_t first, uint32_t last,
+                      uint32_t& hashes, DucoS1Control& ctl);
+
+// LANES 本の連続した nonce を1本の命令列に交互に並べて計算する版（LANES = 2 / 4）。
+// in-order コア（Xtensa LX6）で SHA1 の依存チェーン待ちを別レーンで埋める。
+// どの幅がレジスタに収まるかは実機で測って決める（config.h: MC_DUCO_S1_LANES）
+template <int LANES>
+uint32_t duco_s1_scan_interleaved(const DucoS1Job& job, uint32_t first, uint32_t last,
+                                  uint32_t& hashes, DucoS1Control& ctl);
+
+// LANES 本（4 / 8 / 16）を SIMD で同時に計算する版（主にホスト＝検証用 Linux 機向け）。
+//   4: SSE2 / NEON   8: AVX2（無ければ SSE2 / NEON を2本）   16: AVX-512F（無ければ AVX2 を2本）
+// その幅の命令セットがこのビルドで使えなければ duco_s1_scan にコンパイル時に差し替わる。
+template <int LANES>
+uint32_t duco_s1_scan_vector(const DucoS1Job& job, uint32_t first, uint32_t last,
+                             uint32_t& hashes, DucoS1Control& ctl);
+
+// duco_s1_scan_vector<LANES> が実際に使う実装名（"sse2" / "avx2" / ... / "scalar"）
+template <int LANES>
+const char* duco_s1_vector_backend();
+
+// ---------- nonce の10進表現 ----------
+
+// v を10進 ASCII で dst に書く（終端なし）。戻り値は桁数（最大10）
+static inline int duco_s1_u32_to_dec(char* dst, uint32_t v) {
+  if (v == 0) {
+    dst[0] = '0';
+    return 1;
+  }
+  char tmp[10];
+  int n = 0;
+  while (v) {
+    tmp[n++] = char('0' + (v % 10));
+    v /= 10;
+  }
+  for (int i = 0; i < n; ++i) {
+    dst[i] = tmp[n - 1 - i];
+  }
+  return n;
+}
+
+// digits[0..len) の10進数を in-place で +1 する（オドメータ）。
+// 繰り上がった桁だけを書き換え、全桁 9 のときだけ len が 1 増える。
+// 戻り値: 書き換えた最初の位置（桁数が増えた場合は 0）
+// ※ digits には最大 10 桁ぶんの領域があること
+static inline size_t duco_s1_nonce_inc(char* digits, size_t& len) {
+  size_t i = len;
+  while (i > 0) {
+    --i;
+    if (digits[i] != '9') {
+      ++digits[i];
+      return i;
+    }
+    digits[i] = '0';
+  }
+  // 99..9 -> 100..0
+  digits[0] = '1';
+  digits[len] = '0';
+  ++len;
+  return 0;
+}
+
+// digits に k を足す（レーンごとに LANES ずつ進める用）。戻り値は duco_s1_nonce_inc と同じ
+static inline size_t duco_s1_nonce_add(char* digits, size_t& len, uint32_t k) {
+  if (k == 1) return duco_s1_nonce_inc(digits, len);
+
+  size_t i = len;
+  uint32_t carry = k;
+  while (carry && i > 0) {
+    --i;
+    const uint32_t v = (uint32_t)(digits[i] - '0') + carry;
+    digits[i] = char('0' + v % 10);
+    carry = v / 10;
+  }
+  if (!carry) return i;
+
+  // 桁が増えた：残りの繰り上がりを先頭に足す
+  char head[10];
+  const int hn = duco_s1_u32_to_dec(head, carry);
+  for (size_t j = len; j-- > 0;) digits[j + hn] = digits[j];
+  for (int j = 0; j < hn; ++j) digits[j] = head[j];
+  len += (size_t)hn;
+  return 0;
+}
@@ -0,0 +1,46 @@
+// src/duco_s1_internal.h
+#pragma once
+// duco_s1*.cpp の内部共有（外からは include しない）
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "duco_s1.h"
+
+#define S1_ROTL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define S1_K1 0x5A827999u
+#define S1_K2 0x6ED9EBA1u
+#define S1_K3 0x8F1BBCDCu
+#define S1_K4 0xCA62C1D6u
+
+static const uint32_t S1_H0 = 0x67452301u;
+static const uint32_t S1_H1 = 0xEFCDAB89u;
+static const uint32_t S1_H2 = 0x98BADCFEu;
+static const uint32_t S1_H3 = 0x10325476u;
+static const uint32_t S1_H4 = 0xC3D2E1F0u;
+
+static inline uint32_t load_be32(const uint8_t* p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8)  |  (uint32_t)p[3];
+}
+
+static inline void store_be32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)(v >> 24);
+  p[1] = (uint8_t)(v >> 16);
+  p[2] = (uint8_t)(v >> 8);
+  p[3] = (uint8_t)v;
+}
+
+// メッセージの wi 番目のワード（10..12）を digits + 0x80 パディングから詰める
+static inline uint32_t pack_tail_word(const char* digits, size_t len, size_t wi) {
+  uint32_t v = 0;
+  for (size_t k = 0; k < 4; ++k) {
+    const size_t i = wi * 4 + k - DUCO_S1_SEED_LEN;
+    uint8_t byte = 0;
+    if (i < len)       byte = (uint8_t)digits[i];
+    else if (i == len) byte = 0x80;
+    v = (v << 8) | byte;
+  }
+  return v;
+}
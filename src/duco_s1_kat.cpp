@@ -0,0 +1,123 @@
+// src/duco_s1_kat.cpp
+#include "duco_s1_kat.h"
+
+#include <string.h>
+
+namespace {
+
+// 合成ベクタ（実際のプールのジョブではない）。JOB 応答と同じ形式で、prev は適当な 40 桁 hex、
+// expected は汎用 SHA1 で SHA1(prev + decimal(nonce)) を計算したもの。
+// nonce は 10 進の桁数が変わる境目と、範囲の上端（difficulty*100）を中心に選んである。
+// 実機で記録したジョブは duco-replay kat <trace> の出力を末尾の「記録したジョブ」に足す。
+const DucoS1KatVector kVectors[] = {
+  {"80e53fa5fc25558ae40a502bacafc579abcad9b2", "9c6b37d11ab039922ed88d231ceadb3d8e4afbf8",        1,          0},
+  {"45bdc199959de24d09ffb423c5a2f416f41c225e", "284911cc73a4655409cab35dc34ddb64faa0c0c8",        1,          9},
+  {"c23790036303ee97bfbc0efbd930f7446e9011e0", "c0b1aa25383c381237bdd5ee1bf0a9fff6f80cd9",        1,        100},
+  {"9ec041cbf76f3bbdedbffff4be0e920fb9bbeccf", "8bfb4411a09f1641bbefe1eab51bab8a66808565",        8,         10},
+  {"b346933dda6e82eedccf8d5d73a7e77d95cdc7db", "7cfa71ebfadde89cb009373665244e6e9d6dabfe",        8,         99},
+  {"adb2e9cce27f1e1c0deb706cd3d357dae25dae39", "380cf3f41b7a47b619cb82ed3ed02319967df95c",       75,        999},
+  {"f6f8f11fbd7163bc34caab79958322d2666dcdb5", "0360c7d8633b676504b8f8574c1d55a9c8c8dac8",       75,       1000},
+  {"d204130fd8bf4b7aca954cf3db834033ce16694b", "1875889bca3f93b1cb64d9db4b49ca8e5f59bb45",      300,       9999},
+  {"a241f91bbb578ede74016a2a301462669127be6f", "d0bff74beab871cf8e83d27389a0668e80b1a30b",      300,      10000},
+  {"9cfe5ceecec0c5974f05ee6d70507698e97779f8", "8ff2aa697e05584f08f900a92c16c0aa853213cc",     1500,      99999},
+  {"01c681a4e59d5915cd3fec7d27a365ba8dff74da", "80b3d18f9f223e0e4a216f1161b21534c18b4437",     1500,     100000},
+  {"8411afb8db6213f0a3afae288da02f86b17047c0", "271c1b7cfddbfaa5ae815e906652610eb93c406c",     1500,     131071},
+  {"3f14fc252852a22e3efcaa3066f81df2a32cfe9a", "18df9fa98474da7f1cb651061da70f12e8739a0b",     5000,     271828},
+  {"addb4c37834cce293d021308bb726c80ec96dfb8", "bd757c40b79987ba302a498fd2107786be82d40f",    25000,     999999},
+  {"a4054d3d66d0808042ad95d10c1738903af7b2d4", "81b9a1127e1ad6303932eb4086ff07260f12bb5b",    25000,    1000000},
+  {"d7f3bc2d12597610a1994da4f02f703434bc36fd", "8b5674bedd0f9b9019d1669f43b8ada5580c10b3",    25000,    2500000},
+  {"b28c9152e8c65dc46e1d74411c13a238e5068f77", "6c9f87a90031b7ee0754c1d8eaa7964a12cd2e09",   120000,    9999999},
+  {"7a4c191d562ee44419ddd10b159eb3f8458aa3cd", "1a3b0368624b4599c919ebbd890ff78183715901",   120000,   10000000},
+  {"8694e801be98949b1b8cd08b9fab090293baac7a", "4921ec263dab113e30a15ada2df577ed72778592",   120000,   12000000},
+  {"5e2d0c7b9a8f4e3d2c1b0a9f8e7d6c5b4a392817", "7b01e3477f6bdaa96809001d2c79bf17a7e7159f", 40000000,  999999999},
+  {"5e2d0c7b9a8f4e3d2c1b0a9f8e7d6c5b4a392817", "a63a986734ca1064ca0e2cca86223c3a6a65de25", 40000000, 1000000000},
+  // ---- 記録したジョブ（プールが GOOD / BLOCK を返したもの。duco-replay kat で取り出す） ----
+};
+
+const size_t kCount = sizeof(kVectors) / sizeof(kVectors[0]);
+
+// 正解の前後に取る窓（奇数幅にしてレーンの揃い方を毎回ずらす）
+const uint32_t kBefore = 45;
+const uint32_t kAfter  = 21;
+const uint32_t kMiss   = 40;
+
+int hexNibble_(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+bool parseHex20_(const char* hex, uint8_t out[20]) {
+  if (!hex || strlen(hex) != 40) return false;
+  for (int i = 0; i < 20; ++i) {
+    const int hi = hexNibble_(hex[i * 2]);
+    const int lo = hexNibble_(hex[i * 2 + 1]);
+    if (hi < 0 || lo < 0) return false;
+    out[i] = (uint8_t)((hi << 4) | lo);
+  }
+  return true;
+}
+
+bool fail_(DucoS1KatFailure* fail, int index, bool negative,
+           uint32_t got, uint32_t hashes, uint32_t want) {
+  if (fail) {
+    fail->index    = index;
+    fail->negative = negative;
+    fail->got      = got;
+    fail->hashes   = hashes;
+    fail->want     = want;
+  }
+  return false;
+}
+
+}  // namespace
+
+size_t duco_s1_kat_count() {
+  return kCount;
+}
+
+const DucoS1KatVector& duco_s1_kat_at(size_t i) {
+  return kVectors[i < kCount ? i : 0];
+}
+
+bool duco_s1_kat_run(DucoS1ScanFn scan, DucoS1KatFailure* fail) {
+  if (!scan) return fail_(fail, -1, false, 0, 0, 0);
+
+  for (size_t i = 0; i < kCount; ++i) {
+    const DucoS1KatVector& v = kVectors[i];
+
+    DucoS1Job job;
+    uint8_t   expected[20];
+    if (!duco_s1_prepare(job, v.prev, strlen(v.prev)) || !parseHex20_(v.expected, expected)) {
+      return fail_(fail, (int)i, false, 0, 0, 0);
+    }
+    duco_s1_set_target(job, expected);
+
+    const uint32_t maxNonce = v.difficulty * 100U;
+    DucoS1Control ctl;
+
+    // 1) 正解を含む窓
+    uint32_t lo = (v.nonce > kBefore) ? v.nonce - kBefore : 0;
+    uint32_t hi = (maxNonce - v.nonce > kAfter) ? v.nonce + kAfter : maxNonce;
+    uint32_t hashes = 0;
+    uint32_t got    = scan(job, lo, hi, hashes, ctl);
+    uint32_t want   = v.nonce - lo + 1;
+    if (got != v.nonce || hashes != want) {
+      return fail_(fail, (int)i, false, got, hashes, want);
+    }
+
+    // 2) 正解の直後（範囲の上端なら確かめる範囲が無い）
+    if (v.nonce < maxNonce) {
+      lo     = v.nonce + 1;
+      hi     = (maxNonce - lo > kMiss) ? lo + kMiss : maxNonce;
+      hashes = 0;
+      got    = scan(job, lo, hi, hashes, ctl);
+      want   = hi - lo + 1;
+      if (got != DUCO_S1_NOT_FOUND || hashes != want) {
+        return fail_(fail, (int)i, true, got, hashes, want);
+      }
+    }
+  }
+  return true;
+}
@@ -0,0 +1,40 @@
+// src/duco_s1_kat.h
+#pragma once
+// DUCO-S1 カーネルの既知解テスト（known-answer test）
+//
+// 速いカーネルほど「ビルドや最適化の事故で当たりを黙って捨て続ける」危険があるので、
+// 答えの分かっているジョブ（prev / expected / difficulty / nonce）を解かせて答え合わせしてから使う。
+// ベクタは桁の境目を狙った合成のものと、実機のトレースから取り出したもの（duco-replay kat）。
+// 実機では startMiner()、ホストでは duco-bench が同じベクタを回す。
+//
+// ※ Arduino に依存しない（ホスト側でもそのままビルドできる）こと。
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "duco_s1_kernels.h"
+
+struct DucoS1KatVector {
+  const char* prev;        // 40 桁 hex（JOB 応答の 1 項目目）
+  const char* expected;    // 40 桁 hex（同 2 項目目）
+  uint32_t    difficulty;  // 同 3 項目目（nonce は 0..difficulty*100）
+  uint32_t    nonce;       // 正解
+};
+
+size_t                 duco_s1_kat_count();
+const DucoS1KatVector& duco_s1_kat_at(size_t i);
+
+// 失敗の詳細（ログ / poolDiag 用）
+struct DucoS1KatFailure {
+  int      index    = -1;  // 失敗したベクタ番号
+  bool     negative = false;  // true = 正解を含まない範囲で何か返した / 数え間違えた
+  uint32_t got      = 0;   // カーネルの戻り値
+  uint32_t hashes   = 0;   // カーネルが数えたハッシュ数
+  uint32_t want     = 0;   // 期待したハッシュ数
+};
+
+// 全ベクタについて
+//   1) 正解を含む窓（桁の繰り上がりやレーンの端をまたぐ）で、正解の nonce とハッシュ数が返ること
+//   2) 正解の直後の窓で NOT_FOUND とハッシュ数が返ること（偽の当たりが無いこと）
+// を確かめる。全部通れば true。失敗したら fail（任意）に最初の失敗を書いて false。
+bool duco_s1_kat_run(DucoS1ScanFn scan, DucoS1KatFailure* fail = nullptr);
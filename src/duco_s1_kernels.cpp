@@ -0,0 +1,111 @@
+// src/duco_s1_kernels.cpp
+#include "duco_s1_kernels.h"
+
+#include <string.h>
+
+namespace {
+
+DucoS1Kernel g_kernels[DUCO_S1_MAX_KERNELS];
+size_t       g_count    = 0;
+bool         g_builtins = false;
+
+bool add_(const char* name, DucoS1ScanFn scan) {
+  if (!name || !scan || g_count >= DUCO_S1_MAX_KERNELS) return false;
+  for (size_t i = 0; i < g_count; ++i) {
+    if (strcmp(g_kernels[i].name, name) == 0) return false;
+  }
+  g_kernels[g_count].name = name;
+  g_kernels[g_count].scan = scan;
+  g_count++;
+  return true;
+}
+
+// SIMD はそのビルドで本物が使える幅だけ（スカラーに落ちる幅は scalar と同じなので載せない）
+template <int LANES>
+void addVector_() {
+  const char* backend = duco_s1_vector_backend<LANES>();
+  if (strcmp(backend, "scalar") != 0) add_(backend, duco_s1_scan_vector<LANES>);
+}
+
+void ensureBuiltins_() {
+  if (g_builtins) return;
+  g_builtins = true;
+  add_("scalar", duco_s1_scan);
+  add_("il2", duco_s1_scan_interleaved<2>);
+  add_("il4", duco_s1_scan_interleaved<4>);
+  addVector_<4>();
+  addVector_<8>();
+  addVector_<16>();
+}
+
+// キャリブレーション用の固定 seed（中身に意味はない）
+const char* kCalibSeed = "0f1e2d3c4b5a69788796a5b4c3d2e1f00a1b2c3d";
+
+}  // namespace
+
+size_t duco_s1_kernel_count() {
+  ensureBuiltins_();
+  return g_count;
+}
+
+const DucoS1Kernel* duco_s1_kernel_at(size_t i) {
+  ensureBuiltins_();
+  return (i < g_count) ? &g_kernels[i] : nullptr;
+}
+
+const DucoS1Kernel* duco_s1_kernel_find(const char* name) {
+  ensureBuiltins_();
+  if (!name) return nullptr;
+  for (size_t i = 0; i < g_count; ++i) {
+    if (strcmp(g_kernels[i].name, name) == 0) return &g_kernels[i];
+  }
+  return nullptr;
+}
+
+bool duco_s1_kernel_register(const char* name, DucoS1ScanFn scan) {
+  ensureBuiltins_();
+  return add_(name, scan);
+}
+
+const DucoS1Kernel* duco_s1_calibrate(uint32_t hashesPerKernel, uint64_t (*nowUs)(),
+                                      DucoS1CalibResult* results, size_t maxResults,
+                                      size_t& nResults) {
+  ensureBuiltins_();
+  nResults = 0;
+  if (hashesPerKernel == 0) hashesPerKernel = 1;
+
+  // 最後の nonce を当たりにしておけば、どのカーネルもちょうど hashesPerKernel 回ハッシュする
+  const uint32_t planted = hashesPerKernel - 1;
+  DucoS1Job job;
+  duco_s1_prepare(job, kCalibSeed, DUCO_S1_SEED_LEN);
+  char digits[12];
+  const int nlen = duco_s1_u32_to_dec(digits, planted);
+  uint8_t expected[20];
+  duco_s1_hash(job, digits, (size_t)nlen, expected);
+  duco_s1_set_target(job, expected);
+
+  const DucoS1Kernel* best = nullptr;
+  float bestHps = 0.0f;
+
+  for (size_t i = 0; i < g_count; ++i) {
+    DucoS1CalibResult r;
+    r.kernel = &g_kernels[i];
+
+    DucoS1Control ctl;
+    ctl.every = UINT32_MAX;  // 計測中は制御ポイントを挟まない
+    const uint64_t t0 = nowUs ? nowUs() : 0;
+    const uint32_t found = r.kernel->scan(job, 0, planted, r.hashes, ctl);
+    const uint64_t t1 = nowUs ? nowUs() : 0;
+
+    r.us  = (uint32_t)(t1 - t0);
+    r.ok  = (found == planted) && (r.hashes == hashesPerKernel);
+    r.hps = r.us ? (float)r.hashes * 1e6f / (float)r.us : 0.0f;
+
+    if (r.ok && (!best || r.hps > bestHps)) {
+      best    = r.kernel;
+      bestHps = r.hps;
+    }
+    if (results && nResults < maxResults) results[nResults++] = r;
+  }
+  return best;
+}
@@ -0,0 +1,51 @@
+// src/duco_s1_kernels.h
+#pragma once
+// DUCO-S1 カーネルの登録簿と起動時キャリブレーション
+//
+// どのカーネル（mbedTLS / 1本ずつ / 交互レーン / SIMD）が一番速いかは
+// ビルドフラグ・CPU クロック・ツールチェーンで変わるので、起動時に同じ合成ジョブで測って選ぶ。
+// 全カーネルは duco_s1_scan と同じ約束（duco_s1.h）で呼べること。
+//
+// ※ Arduino に依存しない（ホスト側でもそのままビルドできる）こと。
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "duco_s1.h"
+
+typedef uint32_t (*DucoS1ScanFn)(const DucoS1Job& job, uint32_t first, uint32_t last,
+                                 uint32_t& hashes, DucoS1Control& ctl);
+
+struct DucoS1Kernel {
+  const char*  name;   // ログ / 設定用の短い名前（"scalar", "il2", "avx2", "mbedtls" ...）
+  DucoS1ScanFn scan;
+};
+
+// 登録できる最大数（組み込み + 外部登録）
+static const size_t DUCO_S1_MAX_KERNELS = 12;
+
+// 組み込みカーネル（scalar / il2 / il4 と、このビルドで本物の SIMD が使える幅）は
+// 最初の呼び出しで自動的に登録される。
+size_t              duco_s1_kernel_count();
+const DucoS1Kernel* duco_s1_kernel_at(size_t i);
+const DucoS1Kernel* duco_s1_kernel_find(const char* name);   // 無ければ nullptr
+
+// 外部のカーネル（Arduino 側の mbedTLS 版など）を追加する。満杯 / 同名ありなら false
+bool duco_s1_kernel_register(const char* name, DucoS1ScanFn scan);
+
+// キャリブレーション 1 件分
+struct DucoS1CalibResult {
+  const DucoS1Kernel* kernel = nullptr;
+  bool     ok     = false;  // 仕込んだ nonce を正しく見つけたか
+  uint32_t hashes = 0;
+  uint32_t us     = 0;
+  float    hps    = 0.0f;
+};
+
+// 登録済みの全カーネルに同じ合成ジョブ（最後の nonce が当たり）を hashesPerKernel 個ずつ解かせて測る。
+// nowUs は呼び出し側の時計（実機は micros、ホストは chrono）。
+// results には最大 maxResults 件を登録順に書き、件数を nResults に返す。
+// 戻り値: 正しく解けた中で一番速かったカーネル（全滅なら nullptr）
+const DucoS1Kernel* duco_s1_calibrate(uint32_t hashesPerKernel, uint64_t (*nowUs)(),
+                                      DucoS1CalibResult* results, size_t maxResults,
+                                      size_t& nResults);
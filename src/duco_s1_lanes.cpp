@@ -0,0 +1,485 @@
+// src/duco_s1_lanes.cpp
+// 連続した nonce を「レーン」として並べ、1本の命令列でまとめて計算する DUCO-S1 カーネル。
+//
+// ラウンド計算はレーン型 V に対して1回だけ書いてある。V が用意するもの:
+//   V::kLanes / V::set1(x) / V::load(p) / V::eqmask(x, t)
+//   s1v_add / s1v_xor / s1v_and / s1v_or / s1v_rotl<N>
+//   S1Lanes<L>     : スカラーを L 本並べたもの（SIMD 無しの in-order コア用 = ESP32）
+//   S1Sse2/S1Avx2/S1Avx512/S1Neon : ホスト（検証用 Linux 機）向けの SIMD 版
+//   S1Pair<V>      : V を2本交互に回す（幅を倍にしつつ依存チェーンも埋める）
+// SIMD 版はコンパイラがその命令セットを有効にしているときだけビルドされ、
+// 無い幅は duco_s1_scan（スカラー）にコンパイル時に差し替わる。
+//
+// レーンは 75 ラウンド目の 1 ワード比較（duco_s1_match と同じ早期棄却）までしか回さず、
+// 当たりそうなレーンだけスカラー版で最後まで確かめる。
+
+#include "duco_s1.h"
+#include "duco_s1_internal.h"
+
+#include <string.h>
+
+#if defined(__SSE2__)
+  #include <emmintrin.h>
+#endif
+#if defined(__AVX2__) || defined(__AVX512F__)
+  #include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #include <arm_neon.h>
+  #define S1_HAVE_NEON 1
+#endif
+
+#if defined(__GNUC__)
+  #define S1_INLINE inline __attribute__((always_inline))
+#else
+  #define S1_INLINE inline
+#endif
+
+// ---------- スカラー L 本のレーン型 ----------
+template <int L>
+struct S1Lanes {
+  static_assert(L >= 1 && L <= 4, "S1Lanes supports 1..4 lanes");
+  static const int kLanes = L;
+  uint32_t v[L];
+
+  static S1_INLINE S1Lanes set1(uint32_t x);
+  static S1_INLINE S1Lanes load(const uint32_t* p);
+  static S1_INLINE uint32_t eqmask(const S1Lanes& x, uint32_t t);
+};
+
+// L 本ぶん stmt を展開する（l = レーン番号。L を超える分はコンパイル時に消える）
+#define S1L_EACH(L, stmt)                                 \
+  do {                                                    \
+    { const int l = 0; stmt; }                            \
+    if ((L) > 1) { const int l = 1 % (L); stmt; }         \
+    if ((L) > 2) { const int l = 2 % (L); stmt; }         \
+    if ((L) > 3) { const int l = 3 % (L); stmt; }         \
+  } while (0)
+
+template <int L>
+S1_INLINE S1Lanes<L> S1Lanes<L>::set1(uint32_t x) {
+  S1Lanes<L> r;
+  S1L_EACH(L, r.v[l] = x);
+  return r;
+}
+
+template <int L>
+S1_INLINE S1Lanes<L> S1Lanes<L>::load(const uint32_t* p) {
+  S1Lanes<L> r;
+  S1L_EACH(L, r.v[l] = p[l]);
+  return r;
+}
+
+template <int L>
+S1_INLINE uint32_t S1Lanes<L>::eqmask(const S1Lanes<L>& x, uint32_t t) {
+  uint32_t m = 0;
+  S1L_EACH(L, m |= (uint32_t)(x.v[l] == t) << l);
+  return m;
+}
+
+template <int L>
+static S1_INLINE S1Lanes<L> s1v_add(const S1Lanes<L>& a, const S1Lanes<L>& b) {
+  S1Lanes<L> r;
+  S1L_EACH(L, r.v[l] = a.v[l] + b.v[l]);
+  return r;
+}
+
+template <int L>
+static S1_INLINE S1Lanes<L> s1v_xor(const S1Lanes<L>& a, const S1Lanes<L>& b) {
+  S1Lanes<L> r;
+  S1L_EACH(L, r.v[l] = a.v[l] ^ b.v[l]);
+  return r;
+}
+
+template <int L>
+static S1_INLINE S1Lanes<L> s1v_and(const S1Lanes<L>& a, const S1Lanes<L>& b) {
+  S1Lanes<L> r;
+  S1L_EACH(L, r.v[l] = a.v[l] & b.v[l]);
+  return r;
+}
+
+template <int L>
+static S1_INLINE S1Lanes<L> s1v_or(const S1Lanes<L>& a, const S1Lanes<L>& b) {
+  S1Lanes<L> r;
+  S1L_EACH(L, r.v[l] = a.v[l] | b.v[l]);
+  return r;
+}
+
+template <int N, int L>
+static S1_INLINE S1Lanes<L> s1v_rotl(const S1Lanes<L>& a) {
+  S1Lanes<L> r;
+  S1L_EACH(L, r.v[l] = S1_ROTL(a.v[l], N));
+  return r;
+}
+
+// ---------- SSE2: 4 レーン ----------
+#if defined(__SSE2__)
+struct S1Sse2 {
+  static const int kLanes = 4;
+  __m128i v;
+
+  static S1_INLINE S1Sse2 set1(uint32_t x) {
+    S1Sse2 r; r.v = _mm_set1_epi32((int)x); return r;
+  }
+  static S1_INLINE S1Sse2 load(const uint32_t* p) {
+    S1Sse2 r; r.v = _mm_loadu_si128((const __m128i*)p); return r;
+  }
+  static S1_INLINE uint32_t eqmask(const S1Sse2& x, uint32_t t) {
+    const __m128i eq = _mm_cmpeq_epi32(x.v, _mm_set1_epi32((int)t));
+    return (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(eq));
+  }
+};
+
+static S1_INLINE S1Sse2 s1v_add(const S1Sse2& a, const S1Sse2& b) { S1Sse2 r; r.v = _mm_add_epi32(a.v, b.v); return r; }
+static S1_INLINE S1Sse2 s1v_xor(const S1Sse2& a, const S1Sse2& b) { S1Sse2 r; r.v = _mm_xor_si128(a.v, b.v); return r; }
+static S1_INLINE S1Sse2 s1v_and(const S1Sse2& a, const S1Sse2& b) { S1Sse2 r; r.v = _mm_and_si128(a.v, b.v); return r; }
+static S1_INLINE S1Sse2 s1v_or (const S1Sse2& a, const S1Sse2& b) { S1Sse2 r; r.v = _mm_or_si128(a.v, b.v);  return r; }
+
+template <int N>
+static S1_INLINE S1Sse2 s1v_rotl(const S1Sse2& a) {
+  S1Sse2 r;
+  r.v = _mm_or_si128(_mm_slli_epi32(a.v, N), _mm_srli_epi32(a.v, 32 - N));
+  return r;
+}
+#endif
+
+// ---------- AVX2: 8 レーン ----------
+#if defined(__AVX2__)
+struct S1Avx2 {
+  static const int kLanes = 8;
+  __m256i v;
+
+  static S1_INLINE S1Avx2 set1(uint32_t x) {
+    S1Avx2 r; r.v = _mm256_set1_epi32((int)x); return r;
+  }
+  static S1_INLINE S1Avx2 load(const uint32_t* p) {
+    S1Avx2 r; r.v = _mm256_loadu_si256((const __m256i*)p); return r;
+  }
+  static S1_INLINE uint32_t eqmask(const S1Avx2& x, uint32_t t) {
+    const __m256i eq = _mm256_cmpeq_epi32(x.v, _mm256_set1_epi32((int)t));
+    return (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(eq));
+  }
+};
+
+static S1_INLINE S1Avx2 s1v_add(const S1Avx2& a, const S1Avx2& b) { S1Avx2 r; r.v = _mm256_add_epi32(a.v, b.v); return r; }
+static S1_INLINE S1Avx2 s1v_xor(const S1Avx2& a, const S1Avx2& b) { S1Avx2 r; r.v = _mm256_xor_si256(a.v, b.v); return r; }
+static S1_INLINE S1Avx2 s1v_and(const S1Avx2& a, const S1Avx2& b) { S1Avx2 r; r.v = _mm256_and_si256(a.v, b.v); return r; }
+static S1_INLINE S1Avx2 s1v_or (const S1Avx2& a, const S1Avx2& b) { S1Avx2 r; r.v = _mm256_or_si256(a.v, b.v);  return r; }
+
+template <int N>
+static S1_INLINE S1Avx2 s1v_rotl(const S1Avx2& a) {
+  S1Avx2 r;
+  r.v = _mm256_or_si256(_mm256_slli_epi32(a.v, N), _mm256_srli_epi32(a.v, 32 - N));
+  return r;
+}
+#endif
+
+// ---------- AVX-512F: 16 レーン ----------
+#if defined(__AVX512F__)
+struct S1Avx512 {
+  static const int kLanes = 16;
+  __m512i v;
+
+  static S1_INLINE S1Avx512 set1(uint32_t x) {
+    S1Avx512 r; r.v = _mm512_set1_epi32((int)x); return r;
+  }
+  static S1_INLINE S1Avx512 load(const uint32_t* p) {
+    S1Avx512 r; r.v = _mm512_loadu_si512((const void*)p); return r;
+  }
+  static S1_INLINE uint32_t eqmask(const S1Avx512& x, uint32_t t) {
+    return (uint32_t)_mm512_cmpeq_epi32_mask(x.v, _mm512_set1_epi32((int)t));
+  }
+};
+
+static S1_INLINE S1Avx512 s1v_add(const S1Avx512& a, const S1Avx512& b) { S1Avx512 r; r.v = _mm512_add_epi32(a.v, b.v); return r; }
+static S1_INLINE S1Avx512 s1v_xor(const S1Avx512& a, const S1Avx512& b) { S1Avx512 r; r.v = _mm512_xor_si512(a.v, b.v); return r; }
+static S1_INLINE S1Avx512 s1v_and(const S1Avx512& a, const S1Avx512& b) { S1Avx512 r; r.v = _mm512_and_si512(a.v, b.v); return r; }
+static S1_INLINE S1Avx512 s1v_or (const S1Avx512& a, const S1Avx512& b) { S1Avx512 r; r.v = _mm512_or_si512(a.v, b.v);  return r; }
+
+template <int N>
+static S1_INLINE S1Avx512 s1v_rotl(const S1Avx512& a) {
+  S1Avx512 r; r.v = _mm512_rol_epi32(a.v, N); return r;
+}
+#endif
+
+// ---------- NEON: 4 レーン ----------
+#if defined(S1_HAVE_NEON)
+struct S1Neon {
+  static const int kLanes = 4;
+  uint32x4_t v;
+
+  static S1_INLINE S1Neon set1(uint32_t x) {
+    S1Neon r; r.v = vdupq_n_u32(x); return r;
+  }
+  static S1_INLINE S1Neon load(const uint32_t* p) {
+    S1Neon r; r.v = vld1q_u32(p); return r;
+  }
+  static S1_INLINE uint32_t eqmask(const S1Neon& x, uint32_t t) {
+    const uint32x4_t eq = vceqq_u32(x.v, vdupq_n_u32(t));
+    return (vgetq_lane_u32(eq, 0) & 1u)        | ((vgetq_lane_u32(eq, 1) & 1u) << 1) |
+           ((vgetq_lane_u32(eq, 2) & 1u) << 2) | ((vgetq_lane_u32(eq, 3) & 1u) << 3);
+  }
+};
+
+static S1_INLINE S1Neon s1v_add(const S1Neon& a, const S1Neon& b) { S1Neon r; r.v = vaddq_u32(a.v, b.v); return r; }
+static S1_INLINE S1Neon s1v_xor(const S1Neon& a, const S1Neon& b) { S1Neon r; r.v = veorq_u32(a.v, b.v); return r; }
+static S1_INLINE S1Neon s1v_and(const S1Neon& a, const S1Neon& b) { S1Neon r; r.v = vandq_u32(a.v, b.v); return r; }
+static S1_INLINE S1Neon s1v_or (const S1Neon& a, const S1Neon& b) { S1Neon r; r.v = vorrq_u32(a.v, b.v); return r; }
+
+template <int N>
+static S1_INLINE S1Neon s1v_rotl(const S1Neon& a) {
+  S1Neon r; r.v = vsriq_n_u32(vshlq_n_u32(a.v, N), a.v, 32 - N); return r;
+}
+#endif
+
+// ---------- V を2本交互に回すペア ----------
+template <class V>
+struct S1Pair {
+  static const int kLanes = 2 * V::kLanes;
+  V lo, hi;
+
+  static S1_INLINE S1Pair set1(uint32_t x) {
+    S1Pair r; r.lo = V::set1(x); r.hi = r.lo; return r;
+  }
+  static S1_INLINE S1Pair load(const uint32_t* p) {
+    S1Pair r; r.lo = V::load(p); r.hi = V::load(p + V::kLanes); return r;
+  }
+  static S1_INLINE uint32_t eqmask(const S1Pair& x, uint32_t t) {
+    return V::eqmask(x.lo, t) | (V::eqmask(x.hi, t) << V::kLanes);
+  }
+};
+
+#define S1_PAIR_OP(name)                                                  \
+  template <class V>                                                      \
+  static S1_INLINE S1Pair<V> name(const S1Pair<V>& a, const S1Pair<V>& b) { \
+    S1Pair<V> r; r.lo = name(a.lo, b.lo); r.hi = name(a.hi, b.hi); return r; \
+  }
+S1_PAIR_OP(s1v_add)
+S1_PAIR_OP(s1v_xor)
+S1_PAIR_OP(s1v_and)
+S1_PAIR_OP(s1v_or)
+
+template <int N, class V>
+static S1_INLINE S1Pair<V> s1v_rotl(const S1Pair<V>& a) {
+  S1Pair<V> r; r.lo = s1v_rotl<N>(a.lo); r.hi = s1v_rotl<N>(a.hi); return r;
+}
+
+// ---------- レーン型に対する SHA1 ラウンド ----------
+#define S1V_F1(b, c, d) s1v_xor((d), s1v_and((b), s1v_xor((c), (d))))
+#define S1V_F2(b, c, d) s1v_xor(s1v_xor((b), (c)), (d))
+#define S1V_F3(b, c, d) s1v_or(s1v_and((b), (c)), s1v_and((d), s1v_or((b), (c))))
+#define S1V_F4(b, c, d) s1v_xor(s1v_xor((b), (c)), (d))
+
+#define S1V_R(a, b, c, d, e, F, K, wv)                                  \
+  do {                                                                  \
+    (e) = s1v_add((e), s1v_add(s1v_add(s1v_rotl<5>(a), F((b), (c), (d))), \
+                               s1v_add(V::set1(K), (wv))));             \
+    (b) = s1v_rotl<30>(b);                                              \
+  } while (0)
+
+#define S1V_W(t)                                                          \
+  (W[(t) & 15] = s1v_rotl<1>(s1v_xor(s1v_xor(W[((t) - 3) & 15], W[((t) - 8) & 15]), \
+                                     s1v_xor(W[((t) - 14) & 15], W[(t) & 15]))))
+
+#define S1V_WX(t)                              \
+  ((t) < 16    ? W[(t) & 15]                   \
+   : (t) == 16 ? (W[0] = V::set1(job.w16))     \
+   : (t) == 17 ? (W[1] = V::set1(job.w17))     \
+               : S1V_W(t))
+
+#define S1V_R5(t, F, K)                          \
+  S1V_R(a, b, c, d, e, F, K, S1V_WX((t) + 0));   \
+  S1V_R(e, a, b, c, d, F, K, S1V_WX((t) + 1));   \
+  S1V_R(d, e, a, b, c, F, K, S1V_WX((t) + 2));   \
+  S1V_R(c, d, e, a, b, F, K, S1V_WX((t) + 3));   \
+  S1V_R(b, c, d, e, a, F, K, S1V_WX((t) + 4))
+
+// ---------- レーンごとのメッセージ（SoA: V::load でそのまま読める形） ----------
+template <int L>
+struct S1LaneMsgs {
+  char     d[L][12];   // nonce の10進 ASCII（オドメータで L ずつ進める）
+  size_t   len[L];
+  uint32_t w10[L], w11[L], w12[L], w15[L];
+
+  void pack(int l, size_t fromWord) {
+    if (fromWord <= 10) w10[l] = pack_tail_word(d[l], len[l], 10);
+    if (fromWord <= 11) w11[l] = pack_tail_word(d[l], len[l], 11);
+    w12[l] = pack_tail_word(d[l], len[l], 12);
+  }
+
+  void init(uint32_t first) {
+    for (int l = 0; l < L; ++l) {
+      len[l] = (size_t)duco_s1_u32_to_dec(d[l], first + (uint32_t)l);
+      w15[l] = (uint32_t)((DUCO_S1_SEED_LEN + len[l]) * 8);
+      pack(l, 10);
+    }
+  }
+
+  void advance() {
+    for (int l = 0; l < L; ++l) {
+      const size_t oldLen = len[l];
+      const size_t ch = duco_s1_nonce_add(d[l], len[l], (uint32_t)L);
+      if (len[l] != oldLen) {
+        w15[l] = (uint32_t)((DUCO_S1_SEED_LEN + len[l]) * 8);
+        pack(l, 10);
+      } else {
+        pack(l, (DUCO_S1_SEED_LEN + ch) / 4);
+      }
+    }
+  }
+};
+
+// 全レーンをラウンド 75 まで回し、最終 e が target に一致しそうなレーンのビットを返す
+template <class V>
+static S1_INLINE uint32_t s1v_compress(const DucoS1Job& job,
+                                       const S1LaneMsgs<V::kLanes>& m) {
+  V W[16];
+  for (int i = 0; i < 10; ++i) W[i] = V::set1(job.w[i]);
+  W[10] = V::load(m.w10);
+  W[11] = V::load(m.w11);
+  W[12] = V::load(m.w12);
+  W[13] = V::set1(0);
+  W[14] = V::set1(0);
+  W[15] = V::load(m.w15);
+
+  V a = V::set1(job.s10[0]), b = V::set1(job.s10[1]), c = V::set1(job.s10[2]),
+    d = V::set1(job.s10[3]), e = V::set1(job.s10[4]);
+
+  S1V_R5(10, S1V_F1, S1_K1);
+  S1V_R5(15, S1V_F1, S1_K1);
+  S1V_R5(20, S1V_F2, S1_K2);
+  S1V_R5(25, S1V_F2, S1_K2);
+  S1V_R5(30, S1V_F2, S1_K2);
+  S1V_R5(35, S1V_F2, S1_K2);
+  S1V_R5(40, S1V_F3, S1_K3);
+  S1V_R5(45, S1V_F3, S1_K3);
+  S1V_R5(50, S1V_F3, S1_K3);
+  S1V_R5(55, S1V_F3, S1_K3);
+  S1V_R5(60, S1V_F4, S1_K4);
+  S1V_R5(65, S1V_F4, S1_K4);
+  S1V_R5(70, S1V_F4, S1_K4);
+  S1V_R(a, b, c, d, e, S1V_F4, S1_K4, S1V_WX(75));
+
+  return V::eqmask(e, job.tgt_a76);
+}
+
+// duco_s1_scan と同じ約束で [first, last] を V::kLanes 本ずつ走査する
+template <class V>
+static uint32_t s1v_scan(const DucoS1Job& job, uint32_t first, uint32_t last,
+                         uint32_t& hashes, DucoS1Control& ctl) {
+  const int L = V::kLanes;
+  hashes = 0;
+  if (first > last) return DUCO_S1_NOT_FOUND;
+
+  S1LaneMsgs<L> m;
+  m.init(first);
+
+  uint32_t base      = first;
+  uint32_t untilPoll = ctl.every;
+  for (;;) {
+    const uint32_t remain = last - base;
+    const int valid = (remain >= (uint32_t)(L - 1)) ? L : (int)remain + 1;
+    const uint32_t validMask = (valid >= 32) ? 0xFFFFFFFFu : ((1u << valid) - 1u);
+
+    const uint32_t hit = s1v_compress<V>(job, m) & validMask;
+    if (hit) {
+      // 1 ワード一致の偽陽性を除くため、候補レーンだけ最後まで確かめる
+      for (int l = 0; l < valid; ++l) {
+        if (!((hit >> l) & 1u)) continue;
+        DucoS1Msg msg;
+        if (duco_s1_match(job, msg, m.d[l], m.len[l], 0)) {
+          hashes += (uint32_t)l + 1;
+          return base + (uint32_t)l;
+        }
+      }
+    }
+    hashes += (uint32_t)valid;
+
+    if (valid < L || remain == (uint32_t)(L - 1)) break;
+
+    if (untilPoll <= (uint32_t)valid) {
+      if (ctl.poll && !ctl.poll(ctl, base + (uint32_t)(L - 1))) return DUCO_S1_ABORTED;
+      untilPoll = ctl.every ? ctl.every : 1;
+    } else {
+      untilPoll -= (uint32_t)valid;
+    }
+
+    base += (uint32_t)L;
+    m.advance();
+  }
+  return DUCO_S1_NOT_FOUND;
+}
+
+// ---------- 公開: スカラー交互実行版 ----------
+template <int LANES>
+uint32_t duco_s1_scan_interleaved(const DucoS1Job& job, uint32_t first, uint32_t last,
+                                  uint32_t& hashes, DucoS1Control& ctl) {
+  return s1v_scan<S1Lanes<LANES> >(job, first, last, hashes, ctl);
+}
+
+template uint32_t duco_s1_scan_interleaved<2>(const DucoS1Job&, uint32_t, uint32_t,
+                                              uint32_t&, DucoS1Control&);
+template uint32_t duco_s1_scan_interleaved<4>(const DucoS1Job&, uint32_t, uint32_t,
+                                              uint32_t&, DucoS1Control&);
+
+// ---------- 公開: SIMD 版（ホスト向け） ----------
+// 幅ごとに、このビルドで使える一番速い型を選ぶ（無ければ type = void）
+template <int LANES> struct S1VecFor { typedef void type; static const char* name() { return "scalar"; } };
+
+#if defined(__SSE2__)
+template <> struct S1VecFor<4> { typedef S1Sse2 type; static const char* name() { return "sse2"; } };
+#elif defined(S1_HAVE_NEON)
+template <> struct S1VecFor<4> { typedef S1Neon type; static const char* name() { return "neon"; } };
+#endif
+
+#if defined(__AVX2__)
+template <> struct S1VecFor<8> { typedef S1Avx2 type; static const char* name() { return "avx2"; } };
+#elif defined(__SSE2__)
+template <> struct S1VecFor<8> { typedef S1Pair<S1Sse2> type; static const char* name() { return "sse2x2"; } };
+#elif defined(S1_HAVE_NEON)
+template <> struct S1VecFor<8> { typedef S1Pair<S1Neon> type; static const char* name() { return "neonx2"; } };
+#endif
+
+#if defined(__AVX512F__)
+template <> struct S1VecFor<16> { typedef S1Avx512 type; static const char* name() { return "avx512"; } };
+#elif defined(__AVX2__)
+template <> struct S1VecFor<16> { typedef S1Pair<S1Avx2> type; static const char* name() { return "avx2x2"; } };
+#endif
+
+template <class V>
+struct S1VecScan {
+  static uint32_t scan(const DucoS1Job& job, uint32_t first, uint32_t last,
+                       uint32_t& hashes, DucoS1Control& ctl) {
+    return s1v_scan<V>(job, first, last, hashes, ctl);
+  }
+};
+
+// その幅の SIMD が無いビルドはスカラーへ
+template <>
+struct S1VecScan<void> {
+  static uint32_t scan(const DucoS1Job& job, uint32_t first, uint32_t last,
+                       uint32_t& hashes, DucoS1Control& ctl) {
+    return duco_s1_scan(job, first, last, hashes, ctl);
+  }
+};
+
+template <int LANES>
+uint32_t duco_s1_scan_vector(const DucoS1Job& job, uint32_t first, uint32_t last,
+                             uint32_t& hashes, DucoS1Control& ctl) {
+  return S1VecScan<typename S1VecFor<LANES>::type>::scan(job, first, last, hashes, ctl);
+}
+
+template <int LANES>
+const char* duco_s1_vector_backend() {
+  return S1VecFor<LANES>::name();
+}
+
+template uint32_t duco_s1_scan_vector<4>(const DucoS1Job&, uint32_t, uint32_t,
+                                         uint32_t&, DucoS1Control&);
+template uint32_t duco_s1_scan_vector<8>(const DucoS1Job&, uint32_t, uint32_t,
+                                         uint32_t&, DucoS1Control&);
+template uint32_t duco_s1_scan_vector<16>(const DucoS1Job&, uint32_t, uint32_t,
+                                          uint32_t&, DucoS1Control&);
+template const char* duco_s1_vector_backend<4>();
+template const char* duco_s1_vector_backend<8>();
+template const char* duco_s1_vector_backend<16>();
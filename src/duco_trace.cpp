@@ -0,0 +1,103 @@
+// src/duco_trace.cpp
+#include "duco_trace.h"
+
+#include <string.h>
+
+static const char kMagic[7] = {'D', 'U', 'C', 'O', 'T', 'R', 'C'};
+static const char kHex[]    = "0123456789abcdef";
+
+static inline int hex_nibble_(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+static inline void put_u32_(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static inline uint32_t get_u32_(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+bool duco_trace_set_prev(DucoTraceRecord& r, const char* prev, size_t len) {
+  if (!prev || len != 40) return false;
+  for (int i = 0; i < 20; ++i) {
+    const int hi = hex_nibble_(prev[i * 2]);
+    const int lo = hex_nibble_(prev[i * 2 + 1]);
+    if (hi < 0 || lo < 0) return false;
+    r.prev[i] = (uint8_t)((hi << 4) | lo);
+  }
+  return true;
+}
+
+void duco_trace_prev_hex(const DucoTraceRecord& r, char out[41]) {
+  for (int i = 0; i < 20; ++i) {
+    out[i * 2]     = kHex[r.prev[i] >> 4];
+    out[i * 2 + 1] = kHex[r.prev[i] & 15];
+  }
+  out[40] = '\0';
+}
+
+void duco_trace_write_header(uint8_t out[DUCO_TRACE_HDR_SIZE]) {
+  memset(out, 0, DUCO_TRACE_HDR_SIZE);
+  memcpy(out, kMagic, sizeof(kMagic));
+  out[7] = DUCO_TRACE_VERSION;
+  out[8] = (uint8_t)DUCO_TRACE_REC_SIZE;
+  out[9] = (uint8_t)(DUCO_TRACE_REC_SIZE >> 8);
+}
+
+bool duco_trace_check_header(const uint8_t* p, size_t len) {
+  if (!p || len < DUCO_TRACE_HDR_SIZE) return false;
+  if (memcmp(p, kMagic, sizeof(kMagic)) != 0) return false;
+  const size_t recSize = (size_t)p[8] | ((size_t)p[9] << 8);
+  return p[7] == DUCO_TRACE_VERSION && recSize == DUCO_TRACE_REC_SIZE;
+}
+
+void duco_trace_encode(const DucoTraceRecord& r, uint8_t out[DUCO_TRACE_REC_SIZE]) {
+  memcpy(out, r.prev, 20);
+  memcpy(out + 20, r.expected, 20);
+  put_u32_(out + 40, r.difficulty);
+  put_u32_(out + 44, r.nonce);
+  put_u32_(out + 48, r.hashes);
+  put_u32_(out + 52, r.solve_us);
+  out[56] = r.feedback;
+  out[57] = r.thread;
+  out[58] = (uint8_t)r.flags;
+  out[59] = (uint8_t)(r.flags >> 8);
+}
+
+void duco_trace_decode(const uint8_t in[DUCO_TRACE_REC_SIZE], DucoTraceRecord& r) {
+  memcpy(r.prev, in, 20);
+  memcpy(r.expected, in + 20, 20);
+  r.difficulty = get_u32_(in + 40);
+  r.nonce      = get_u32_(in + 44);
+  r.hashes     = get_u32_(in + 48);
+  r.solve_us   = get_u32_(in + 52);
+  r.feedback   = in[56];
+  r.thread     = in[57];
+  r.flags      = (uint16_t)(in[58] | (in[59] << 8));
+}
+
+void duco_trace_to_hex(const uint8_t rec[DUCO_TRACE_REC_SIZE], char* out) {
+  for (size_t i = 0; i < DUCO_TRACE_REC_SIZE; ++i) {
+    out[i * 2]     = kHex[rec[i] >> 4];
+    out[i * 2 + 1] = kHex[rec[i] & 15];
+  }
+  out[DUCO_TRACE_REC_SIZE * 2] = '\0';
+}
+
+bool duco_trace_from_hex(const char* hex, size_t len, uint8_t rec[DUCO_TRACE_REC_SIZE]) {
+  if (!hex || len != DUCO_TRACE_REC_SIZE * 2) return false;
+  for (size_t i = 0; i < DUCO_TRACE_REC_SIZE; ++i) {
+    const int hi = hex_nibble_(hex[i * 2]);
+    const int lo = hex_nibble_(hex[i * 2 + 1]);
+    if (hi < 0 || lo < 0) return false;
+    rec[i] = (uint8_t)((hi << 4) | lo);
+  }
+  return true;
+}
@@ -0,0 +1,59 @@
+// src/duco_trace.h
+#pragma once
+// ジョブのトレース（1 ジョブ = 固定長 1 レコード）
+//
+// 実機の I/O タスクが feedback まで揃ったところで 1 件書き（LittleFS / シリアル）、
+// ホストの test/duco-replay が同じジョブ列を好きなカーネルで解き直す。
+//
+// ファイル: ヘッダ DUCO_TRACE_HDR_SIZE バイト + レコード DUCO_TRACE_REC_SIZE バイト × n
+//   ヘッダ  : "DUCOTRC" + 版(1) + レコード長(u16) + 予約(6)
+//   レコード: prev(20) expected(20) difficulty nonce hashes solve_us（各 u32）
+//             feedback(u8) thread(u8) flags(u16)      ※数値はすべてリトルエンディアン
+//   flags   : bit0 = duco-replay synth で作った（実機のジョブではない）。実機は 0
+// シリアルでは 1 レコードを "@TRC <hex>" の 1 行で流す（ログと混ざっても拾える）。
+// ※ Arduino に依存しない（ホスト側でもそのままビルドできる）こと。
+
+#include <stddef.h>
+#include <stdint.h>
+
+static const size_t  DUCO_TRACE_HDR_SIZE = 16;
+static const size_t  DUCO_TRACE_REC_SIZE = 60;
+static const uint8_t DUCO_TRACE_VERSION  = 1;
+static const uint16_t DUCO_TRACE_FLAG_SYNTH = 0x0001;
+
+enum DucoTraceFeedback : uint8_t {
+  DUCO_TRACE_FB_GOOD = 0,
+  DUCO_TRACE_FB_BLOCK,
+  DUCO_TRACE_FB_BAD,
+  DUCO_TRACE_FB_NONE,   // 範囲内に答えが無かった（submit していない）
+  DUCO_TRACE_FB_LOST,   // submit したが feedback の前に切れた / タイムアウト
+};
+
+struct DucoTraceRecord {
+  uint8_t  prev[20];          // prev（40 桁 hex）をバイトに
+  uint8_t  expected[20];
+  uint32_t difficulty = 0;
+  uint32_t nonce      = 0;    // 見つけた nonce（DUCO_TRACE_FB_NONE なら 0xFFFFFFFF）
+  uint32_t hashes     = 0;    // 解くのに回した数（停めていた分も含む）
+  uint32_t solve_us   = 0;    // 解くのにかかった計算時間（停めていた間・yield は含まない）
+  uint8_t  feedback   = DUCO_TRACE_FB_NONE;
+  uint8_t  thread     = 0;    // 解いたワーカー
+  uint16_t flags      = 0;    // DUCO_TRACE_FLAG_*（実機は 0）
+};
+
+// prev が 40 桁 hex のときだけ true（DUCO の prev は常にそう）
+bool duco_trace_set_prev(DucoTraceRecord& r, const char* prev, size_t len);
+// prev を 40 桁 hex に（終端付き）
+void duco_trace_prev_hex(const DucoTraceRecord& r, char out[41]);
+
+void duco_trace_write_header(uint8_t out[DUCO_TRACE_HDR_SIZE]);
+// 先頭がトレースのヘッダで、版とレコード長が読めるものなら true
+bool duco_trace_check_header(const uint8_t* p, size_t len);
+
+void duco_trace_encode(const DucoTraceRecord& r, uint8_t out[DUCO_TRACE_REC_SIZE]);
+void duco_trace_decode(const uint8_t in[DUCO_TRACE_REC_SIZE], DucoTraceRecord& r);
+
+// シリアル用の hex（小文字、終端付き。out は 2 * DUCO_TRACE_REC_SIZE + 1 バイト）
+void duco_trace_to_hex(const uint8_t rec[DUCO_TRACE_REC_SIZE], char* out);
+// hex の桁数がちょうど 1 レコード分のときだけ true
+bool duco_trace_from_hex(const char* hex, size_t len, uint8_t rec[DUCO_TRACE_REC_SIZE]);
@@ -95,7 +95,7 @@ static void handleSetupLine(const char* line) {
     return;
   }
   if (cmd.equalsIgnoreCase("HELP")) {
-    Serial.println("@OK CMDS=HELLO,PING,GET INFO,HELP");
+    Serial.println("@OK CMDS=HELLO,PING,GET INFO,GET MINING,GET POOLS,@JOBS,GET JOBS,GET LATENCY,GET LIFETIME,TRACE,HELP");
     return;
   }
   if (cmd.equalsIgnoreCase("GET INFO")) {
@@ -108,6 +108,148 @@ static void handleSetupLine(const char* line) {
     return;
   }
 
+  // ★追加: マイニングのテレメトリ（1行 JSON）
+  if (cmd.equalsIgnoreCase("GET MINING")) {
+    MiningSummary ms;
+    updateMiningSummary(ms);
+    char buf[512];
+    snprintf(buf, sizeof(buf),
+             "@MINING {\"hr_kh\":%.2f,\"acc\":%u,\"rej\":%u,\"diff\":%u,\"ping_ms\":%.1f,"
+             "\"threads\":%u,\"workers\":%u,\"paused\":%d,"
+             "\"resume_us\":%u,\"resume_max_us\":%u,\"resume_n\":%u,"
+             "\"fb_ms\":%.1f,\"solve_ms\":%.1f,\"turn_ms\":%.1f,\"pipeline\":%d,"
+             "\"pool_cached\":%d,\"first_job_ms\":%u,"
+             "\"pool_score\":%.1f,\"pool_best_score\":%.1f,\"pool_cands\":%u,"
+             "\"hr_wall_kh\":%.2f,\"hr_compute_kh\":%.2f,\"hr_policy\":\"%s\","
+             "\"hr_ewma_kh\":%.2f}",
+             ms.total_kh, (unsigned)ms.accepted, (unsigned)ms.rejected,
+             (unsigned)ms.maxDifficulty, ms.maxPingMs,
+             (unsigned)getMiningActiveThreads(), (unsigned)getMiningWorkerCount(),
+             isMiningPaused() ? 1 : 0,
+             (unsigned)ms.resumeLatencyUs, (unsigned)ms.resumeLatencyMaxUs,
+             (unsigned)ms.resumeCount,
+             ms.maxFeedbackMs, ms.maxSolveMs, ms.maxTurnMs, ms.pipelined ? 1 : 0,
+             ms.poolCached ? 1 : 0, (unsigned)ms.firstJobMs,
+             ms.poolScore < DUCO_POOL_SCORE_NONE ? ms.poolScore : -1.0f,
+             ms.poolBestScore < DUCO_POOL_SCORE_NONE ? ms.poolBestScore : -1.0f,
+             (unsigned)ms.poolCandidates,
+             ms.total_kh_wall, ms.total_kh_compute,
+             ms.hashratePolicy == MINING_HR_COMPUTE ? "compute" : "wall",
+             ms.total_kh_ewma);
+    Serial.println(buf);
+    return;
+  }
+
+  // ★追加: 遅れの分布（1行 JSON。p50 / p95 / p99 / max は ms、まだ無ければ -1）
+  if (cmd.equalsIgnoreCase("GET LATENCY")) {
+    MiningSummary ms;
+    updateMiningSummary(ms);
+    const MiningLatency* lat[3] = {&ms.latJob, &ms.latFeedback, &ms.latConnect};
+    static const char*   kName[3] = {"job", "fb", "conn"};
+    Serial.print("@LATENCY {");
+    for (int i = 0; i < 3; ++i) {
+      Serial.printf("%s\"%s\":{\"n\":%u,\"p50\":%.0f,\"p95\":%.0f,\"p99\":%.0f,\"max\":%.0f}",
+                    i ? "," : "", kName[i], (unsigned)lat[i]->n,
+                    lat[i]->p50, lat[i]->p95, lat[i]->p99, lat[i]->max);
+    }
+    Serial.println("}");
+    return;
+  }
+
+  // ★追加: 起動をまたいだ通算（1行 JSON。avg_kh = hashes / mining_s）
+  if (cmd.equalsIgnoreCase("GET LIFETIME")) {
+    MiningLifetime lt;
+    getMiningLifetime(lt);
+    const double avgKh = lt.mining_s ? (double)lt.hashes / lt.mining_s / 1000.0 : 0.0;
+    Serial.printf("@LIFETIME {\"boots\":%u,\"accepted\":%u,\"rejected\":%u,\"hashes\":%llu,"
+                  "\"uptime_s\":%u,\"mining_s\":%u,\"avg_kh\":%.2f,\"seq\":%u,\"flushes\":%u,"
+                  "\"persisted\":%s}\n",
+                  (unsigned)lt.boots, (unsigned)lt.accepted, (unsigned)lt.rejected,
+                  (unsigned long long)lt.hashes, (unsigned)lt.uptime_s, (unsigned)lt.mining_s,
+                  avgKh, (unsigned)lt.seq, (unsigned)lt.flushes, lt.persisted ? "true" : "false");
+    return;
+  }
+
+  // ★追加: プールノードの候補とスコア（1行 JSON。score / 時間は未計測なら -1）
+  if (cmd.equalsIgnoreCase("GET POOLS")) {
+    DucoPoolCand cands[DUCO_POOL_MAX_CANDS];
+    int cur = -1;
+    const int n = getPoolCandidates(cands, DUCO_POOL_MAX_CANDS, &cur);
+    static const char* kOrigin[] = {"getpool", "user", "cache"};
+    Serial.print("@POOLS [");
+    for (int i = 0; i < n; ++i) {
+      const DucoPoolCand& c = cands[i];
+      const float score = duco_pool_sel_score(c);
+      char buf[256];
+      snprintf(buf, sizeof(buf),
+               "%s{\"name\":\"%s\",\"host\":\"%s\",\"port\":%u,\"from\":\"%s\",\"cur\":%d,"
+               "\"connect_ms\":%.1f,\"banner_ms\":%.1f,\"probes\":%u,\"probe_fails\":%u,"
+               "\"acc\":%u,\"rej\":%u,\"score\":%.1f}",
+               i ? "," : "", c.name, c.host, (unsigned)c.port,
+               kOrigin[c.origin <= DUCO_POOL_FROM_CACHE ? c.origin : 0], i == cur ? 1 : 0,
+               c.connect_ms, c.banner_ms, (unsigned)c.probes, (unsigned)c.probe_fails,
+               (unsigned)c.accepted, (unsigned)c.rejected,
+               score < DUCO_POOL_SCORE_NONE ? score : -1.0f);
+      Serial.print(buf);
+    }
+    Serial.println("]");
+    return;
+  }
+
+  // ★追加: 直近のジョブの記録（@JOBS [n] / GET JOBS [n]。1行 JSON、rows は古い順で列は cols の順）
+  if (cmd.equalsIgnoreCase("@JOBS") || cmd.equalsIgnoreCase("GET JOBS") ||
+      cmd.startsWith("@JOBS ") || cmd.startsWith("GET JOBS ")) {
+    static MiningJobRecord jobs[MC_DUCO_JOB_RING];   // ループのスタックを使わない
+    String arg = cmd.substring(cmd.charAt(0) == '@' ? 5 : 8);
+    arg.trim();
+    const long want = arg.length() ? arg.toInt() : (long)MC_DUCO_JOB_RING;
+    if (want <= 0) {
+      Serial.println("@ERR bad_jobs_count");
+      return;
+    }
+    uint32_t seq = 0;
+    const int n = getMiningJobs(jobs, want < MC_DUCO_JOB_RING ? (int)want : MC_DUCO_JOB_RING, &seq);
+    static const char* kRes[] = {"good", "block", "bad", "none", "lost", "drop"};
+    Serial.printf("@JOBS {\"n\":%d,\"seq\":%u,\"now_ms\":%lu,"
+                  "\"cols\":\"seq,end_ms,thr,conn,diff,hashes,compute_us,wall_us,pause_us,"
+                  "ping_ms,fb_ms,res\",\"rows\":[",
+                  n, (unsigned)seq, (unsigned long)millis());
+    for (int i = n - 1; i >= 0; --i) {
+      const MiningJobRecord& j = jobs[i];
+      Serial.printf("%s[%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,\"%s\"]", i == n - 1 ? "" : ",",
+                    (unsigned)j.seq, (unsigned)j.end_ms, (unsigned)j.thread, (unsigned)j.conn,
+                    (unsigned)j.difficulty, (unsigned)j.hashes, (unsigned)j.compute_us,
+                    (unsigned)j.wall_us, (unsigned)j.pause_us, (unsigned)j.ping_ms,
+                    (unsigned)j.fb_ms, kRes[j.result <= MINING_JOB_DROP ? j.result : MINING_JOB_NONE]);
+    }
+    Serial.println("]}");
+    return;
+  }
+
+  // ★追加: ジョブのトレース（TRACE FS|SERIAL|OFF|DUMP|CLEAR。DUMP は "@TRC <hex>" の行の後に @TRACE END）
+  if (cmd.startsWith("TRACE ") || cmd.equalsIgnoreCase("TRACE")) {
+    String arg = cmd.substring(5);
+    arg.trim();
+    if (arg.equalsIgnoreCase("FS"))          setMiningTrace(MINING_TRACE_FS);
+    else if (arg.equalsIgnoreCase("SERIAL")) setMiningTrace(MINING_TRACE_SERIAL);
+    else if (arg.equalsIgnoreCase("OFF"))    setMiningTrace(MINING_TRACE_OFF);
+    else if (arg.equalsIgnoreCase("DUMP")) {
+      const int n = dumpMiningTrace(Serial);
+      if (n < 0) Serial.println("@ERR trace_busy_or_empty");
+      else       Serial.printf("@TRACE END n=%d\n", n);
+      return;
+    } else if (arg.equalsIgnoreCase("CLEAR")) {
+      Serial.println(clearMiningTrace() ? "@OK TRACE CLEAR" : "@ERR trace_busy");
+      return;
+    } else if (arg.length()) {
+      Serial.println("@ERR bad_trace_mode");
+      return;
+    }
+    static const char* kMode[] = {"OFF", "FS", "SERIAL"};
+    Serial.printf("@OK TRACE %s\n", kMode[getMiningTrace() <= MINING_TRACE_SERIAL ? getMiningTrace() : 0]);
+    return;
+  }
+
     if (cmd.equalsIgnoreCase("GET CFG")) {
     String j = mcConfigGetMaskedJson();
     Serial.print("@CFG ");
@@ -180,6 +322,19 @@ static void handleSetupLine(const char* line) {
         mc_logf("[MAIN] cpu_mhz set: %d (now=%d)", mhz, getCpuFrequencyMhz());
       }
 
+      // ★追加: ワーカー構成はタスクを作り直さないと変わらないので、保存して再起動後に反映
+      if (key.equalsIgnoreCase("miner_threads") ||
+          key.equalsIgnoreCase("miner_cores") ||
+          key.equalsIgnoreCase("miner_prio")) {
+        mc_logf("[MAIN] %s set: %s (applies after SAVE + reboot)", key.c_str(), val.c_str());
+      }
+
+      // ★追加: 候補に足して、すぐ測り直す（乗り換えるかは測った結果次第）
+      if (key.equalsIgnoreCase("pool_nodes")) {
+        mc_logf("[MAIN] pool_nodes set: %s", val.c_str());
+        requestPoolProbe();
+      }
+
 
 
 
@@ -205,6 +360,15 @@ static void handleSetupLine(const char* line) {
   }
 
   if (cmd.equalsIgnoreCase("REBOOT")) {
+    // ★追加: 通算カウンタを書いてから（I/O タスクが次の 1 秒で書く。最大 1.5 秒待つ）
+    MiningLifetime lt;
+    getMiningLifetime(lt);
+    const uint32_t flushes = lt.flushes;
+    requestMiningLifetimeFlush();
+    for (uint32_t t0 = millis(); lt.persisted && millis() - t0 < 1500; delay(20)) {
+      getMiningLifetime(lt);
+      if (lt.flushes != flushes) break;
+    }
     Serial.println("@OK REBOOT");
     Serial.flush();
     delay(100);
@@ -917,6 +1081,12 @@ void loop() {
 
     String ticker = buildTicker(summary);
 
+    // ★追加: ティッカーが見えているときだけ次のフレーム用の実値サンプルを要求する
+    // （画面 OFF 中はここまで来ないので、solver は演出用の仕事をしない）
+    if (g_mode == MODE_DASH) {
+      requestMiningWorkSample();
+    }
+
     // 画面描画
     if (g_mode == MODE_STACKCHAN) {
       ui.drawStackchanScreen(data);
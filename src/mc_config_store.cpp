@@ -8,6 +8,7 @@
 
 #include "config.h"   // config_private.h の読み込み条件(MC_DISABLE_CONFIG_PRIVATE)を尊重
 #include "logging.h"
+#include "duco_pool_select.h"   // ★追加: pool_nodes の書式チェック
 
 // ---- defaults (config_private.h で上書き可能) ----
 
@@ -91,6 +92,14 @@ struct RuntimeCfg {
   // ★追加：カスタムセリフ
   String speech_share_accepted; // 「シェア獲得したよ」
   String speech_hello;          // 「こんにちはマイニングスタックチャンです」
+
+  // ★追加：マイナーのワーカー構成（startMiner で反映）
+  uint8_t miner_threads = (uint8_t)MC_MINER_THREADS;  // 1..MC_MINER_MAX_THREADS
+  String  miner_cores;                                 // "0,1" / "1,1,1" / "a" ...
+  uint8_t miner_prio    = (uint8_t)MC_MINER_PRIO;     // 1..configMAX_PRIORITIES-1
+
+  // ★追加：プールノードの候補に足すノード（"host:port,..."）
+  String pool_nodes;
 };
 
 
@@ -121,6 +130,34 @@ static void applyDefaults_() {
   // ★追加：セリフのデフォルト投入
   g_rt.speech_share_accepted = MC_SPEECH_SHARE_ACCEPTED;
   g_rt.speech_hello          = MC_SPEECH_HELLO;
+
+  // ★追加：マイナーのワーカー構成
+  g_rt.miner_threads = (uint8_t)MC_MINER_THREADS;
+  g_rt.miner_cores   = MC_MINER_CORES;
+  g_rt.miner_prio    = (uint8_t)MC_MINER_PRIO;
+
+  g_rt.pool_nodes    = MC_DUCO_POOL_NODES;
+}
+
+// ★追加：miner_cores は "0" / "1" / "a" をカンマで並べたもの（1..MC_MINER_MAX_THREADS 個）
+static bool validMinerCores_(const String& s) {
+  int  n    = 0;
+  bool item = false;   // 今の区切りに 0/1/a が1つ入ったか
+  for (const char* p = s.c_str(); ; ++p) {
+    const char c = *p;
+    if (c == ',' || c == '\0') {
+      if (!item) return false;
+      if (++n > MC_MINER_MAX_THREADS) return false;
+      if (c == '\0') break;
+      item = false;
+    } else if (c == '0' || c == '1' || c == 'a') {
+      if (item) return false;
+      item = true;
+    } else if (c != ' ') {
+      return false;
+    }
+  }
+  return n > 0;
 }
 
 
@@ -226,6 +263,24 @@ static void loadOnce_() {
   setStr("share_accepted_text", g_rt.speech_share_accepted);
   setStr("hello_text",          g_rt.speech_hello);
 
+  // ★追加：マイナーのワーカー構成（範囲外は既定値のまま）
+  if (!doc["miner_threads"].isNull()) {
+    int n = doc["miner_threads"].as<int>();
+    if (n >= 1 && n <= MC_MINER_MAX_THREADS) g_rt.miner_threads = (uint8_t)n;
+  }
+  if (!doc["miner_cores"].isNull()) {
+    String c = doc["miner_cores"].as<String>();
+    if (validMinerCores_(c)) g_rt.miner_cores = c;
+  }
+  if (!doc["miner_prio"].isNull()) {
+    int p = doc["miner_prio"].as<int>();
+    if (p >= 1 && p < (int)configMAX_PRIORITIES) g_rt.miner_prio = (uint8_t)p;
+  }
+  if (!doc["pool_nodes"].isNull()) {
+    String n = doc["pool_nodes"].as<String>();
+    if (duco_pool_parse_nodes(n.c_str(), nullptr) >= 0) g_rt.pool_nodes = n;
+  }
+
   mc_logf("[CFG] loaded %s\n", kCfgPath);
 }
 
@@ -319,6 +374,49 @@ bool mcConfigSetKV(const String& key, const String& value, String& err) {
     return true;
   }
 
+  // ★追加：マイナーのワーカー構成（反映は次の startMiner = 再起動後）
+  if (key == "miner_threads") {
+    char* endp = nullptr;
+    long v = strtol(value.c_str(), &endp, 10);
+    if (endp == value.c_str() || v < 1 || v > MC_MINER_MAX_THREADS) {
+      err = "range(1-" + String(MC_MINER_MAX_THREADS) + ")";
+      return false;
+    }
+    g_rt.miner_threads = (uint8_t)v;
+    setDirty();
+    return true;
+  }
+  if (key == "miner_cores") {
+    if (!validMinerCores_(value)) {
+      err = "format(0|1|a,...)";
+      return false;
+    }
+    g_rt.miner_cores = value;
+    setDirty();
+    return true;
+  }
+  if (key == "miner_prio") {
+    char* endp = nullptr;
+    long v = strtol(value.c_str(), &endp, 10);
+    if (endp == value.c_str() || v < 1 || v >= (long)configMAX_PRIORITIES) {
+      err = "range(1-" + String((int)configMAX_PRIORITIES - 1) + ")";
+      return false;
+    }
+    g_rt.miner_prio = (uint8_t)v;
+    setDirty();
+    return true;
+  }
+  if (key == "pool_nodes") {
+    const int n = duco_pool_parse_nodes(value.c_str(), nullptr);
+    if (n < 0 || n > DUCO_POOL_MAX_CANDS - 2) {
+      err = "format(host:port,...) max " + String(DUCO_POOL_MAX_CANDS - 2);
+      return false;
+    }
+    g_rt.pool_nodes = value;
+    setDirty();
+    return true;
+  }
+
   err = "unknown_key";
   return false;
 }
@@ -358,6 +456,12 @@ bool mcConfigSave(String& err) {
   doc["share_accepted_text"] = g_rt.speech_share_accepted;
   doc["hello_text"]          = g_rt.speech_hello;
 
+  // ★追加：マイナーのワーカー構成
+  doc["miner_threads"] = g_rt.miner_threads;
+  doc["miner_cores"]   = g_rt.miner_cores;
+  doc["miner_prio"]    = g_rt.miner_prio;
+  doc["pool_nodes"]    = g_rt.pool_nodes;
+
   File f = LittleFS.open(kCfgPath, "w");
   if (!f) {
     err = "open_failed";
@@ -423,6 +527,12 @@ String mcConfigGetMaskedJson() {
   doc["share_accepted_text"] = g_rt.speech_share_accepted;
   doc["hello_text"]          = g_rt.speech_hello;
 
+  // ★追加：マイナーのワーカー構成
+  doc["miner_threads"] = g_rt.miner_threads;
+  doc["miner_cores"]   = g_rt.miner_cores;
+  doc["miner_prio"]    = g_rt.miner_prio;
+  doc["pool_nodes"]    = g_rt.pool_nodes;
+
   String out;
   serializeJson(doc, out);
   return out;
@@ -454,3 +564,9 @@ const char* mcCfgHelloText()         { loadOnce_(); return g_rt.speech_hello.c_s
 
 // ★追加：CPU動作周波数 getter
 uint32_t mcCfgCpuMhz() { loadOnce_(); return (uint32_t)g_rt.cpu_mhz; }
+
+// ★追加：マイナーのワーカー構成 getters
+uint8_t     mcCfgMinerThreads() { loadOnce_(); return g_rt.miner_threads; }
+const char* mcCfgMinerCores()   { loadOnce_(); return g_rt.miner_cores.c_str(); }
+uint8_t     mcCfgMinerPrio()    { loadOnce_(); return g_rt.miner_prio; }
+const char* mcCfgPoolNodes()    { loadOnce_(); return g_rt.pool_nodes.c_str(); }
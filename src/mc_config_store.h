@@ -37,3 +37,11 @@ const char* mcCfgShareAcceptedText();
 const char* mcCfgHelloText();
 
 uint32_t mcCfgCpuMhz();
+
+// ★追加：マイナーのワーカー構成（startMiner で読む。変更は再起動後に反映）
+uint8_t     mcCfgMinerThreads();   // ワーカー数 1..MC_MINER_MAX_THREADS
+const char* mcCfgMinerCores();     // ワーカー i のコア（"0,1" の i 番目、a = 指定なし）
+uint8_t     mcCfgMinerPrio();      // タスク優先度
+
+// ★追加：プールノードの候補に足すノード（"host:port,..."。空 = getPool だけ）
+const char* mcCfgPoolNodes();
@@ -8,16 +8,69 @@
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
 #include <mbedtls/sha1.h>
+#include <LittleFS.h>
 
 #include "runtime_features.h"
+#include "mc_config_store.h"
+#include "duco_s1.h"
+#include "duco_s1_kernels.h"
+#include "duco_s1_kat.h"
+#include "duco_proto.h"
+#include "duco_io.h"
+#include "duco_pool_cache.h"
+#include "duco_pool_select.h"
+#include "duco_trace.h"
+#include "duco_hr_series.h"
+#include "duco_latency_hist.h"
+#include "duco_lifetime.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/event_groups.h"
 
 
 static volatile bool g_miningPaused = false;
 
+// ---- ★追加: pause / enable の通知（イベントグループ）----
+// ワーカーは sleep で様子を見るのではなく、ビットが立つのを待って即座に起きる。
+//   EVT_RUN        : 一時停止していない
+//   EVT_ENABLED(i) : スレッド i が有効（setMiningActiveThreads）
+static EventGroupHandle_t g_ctlEvents = nullptr;
+static const EventBits_t  EVT_RUN = (EventBits_t)1u << 0;
+static inline EventBits_t EVT_ENABLED(int i) { return (EventBits_t)1u << (1 + i); }
+
+// ★追加: 再開（resume / enable）の合図からワーカーが起きるまでの時間 [us]
+static volatile int64_t  g_resumeSignalUs = 0;   // 最後に合図した時刻（0 = 未計測）
+static volatile uint32_t g_resumeLastUs   = 0;
+static volatile uint32_t g_resumeMaxUs    = 0;
+static volatile uint32_t g_resumeCount    = 0;
+
+static void ctl_sync_bits_();  // 現在の pause / active threads をビットに反映（下で定義）
+
+static EventGroupHandle_t ctl_events_() {
+  if (!g_ctlEvents) {
+    g_ctlEvents = xEventGroupCreate();
+    ctl_sync_bits_();
+  }
+  return g_ctlEvents;
+}
+
+// 待っていたワーカーが起きたところで呼ぶ
+static void note_resumed_() {
+  const int64_t sig = g_resumeSignalUs;
+  if (!sig) return;
+  const int64_t d = esp_timer_get_time() - sig;
+  const uint32_t lat = (d > 0) ? (uint32_t)d : 0;
+  g_resumeLastUs = lat;
+  if (lat > g_resumeMaxUs) g_resumeMaxUs = lat;
+  g_resumeCount = g_resumeCount + 1;
+}
+
 void setMiningPaused(bool paused) {
+  const bool was = g_miningPaused;
   g_miningPaused = paused;
+  if (was && !paused) g_resumeSignalUs = esp_timer_get_time();
+  ctl_sync_bits_();
 }
 
 bool isMiningPaused() {
@@ -25,44 +78,108 @@ bool isMiningPaused() {
 }
 
 // “pause中はここで待つ” ユーティリティ（忙しいループに入れやすい）
+// ★変更: 10ms ごとに覗くのをやめ、EVT_RUN が立った瞬間に起きる
 static inline void waitWhilePaused_() {
+  if (!g_miningPaused) return;
   while (g_miningPaused) {
-    vTaskDelay(pdMS_TO_TICKS(10));
+    // 念のためのタイムアウト付き（通知の取りこぼしがあっても 1 秒で見直す）
+    xEventGroupWaitBits(ctl_events_(), EVT_RUN, pdFALSE, pdTRUE, pdMS_TO_TICKS(1000));
   }
+  note_resumed_();
 }
 
 
 // ---------------- Duino-Coin 固定値 ----------------
-static const uint8_t DUCO_MINER_THREADS = 2;
+// ★変更: ワーカー数は実行時設定（mc_config_store: miner_threads）。静的な領域は MAX で確保する
+static const uint8_t DUCO_MINER_MAX_THREADS = MC_MINER_MAX_THREADS;
+static_assert(MC_MINER_MAX_THREADS >= 1 && MC_MINER_MAX_THREADS <= 22,
+              "EVT_ENABLED(i) must fit in the event group bits");
 static const char*   DUCO_POOL_URL      = "https://server.duinocoin.com/getPool";
 
 // ---------------- 内部状態 ----------------
+// ★追加: SHA1 演出用（実値）スナップショットの中身
+struct DucoWorkData {
+  bool     valid      = false;
+  uint32_t stamp      = 0;      // 応えた要求の番号（大きいほど新しい）
+  uint32_t nonce      = 0;
+  uint32_t max_nonce  = 0;
+  uint32_t diff       = 0;
+  uint8_t  out[20]    = {0};    // out[20] の生バイト
+  char     seed[41]   = {0};    // prev（最大40）
+};
+
+// ★変更: 書き手はそのスレッド自身の1つだけなので、ロックではなく seqlock で公開する。
+// 書き手は seq を奇数にしてから書き、書き終えたら偶数に戻す（待たない・割り込みも止めない）。
+// 読み手は seq が奇数 / 読む前後で変わっていたら読み直す（work_read_）。
+struct DucoWorkSnap {
+  uint32_t     seq = 0;
+  DucoWorkData d;
+};
+
+// ★変更: ワーカーは計算だけ。接続・シェアの統計はプール接続ごと（DucoConn）に持つ
 struct DucoThreadStats {
-  bool     connected    = false;
-  float    hashrate_kh  = 0.0f;
-  uint32_t shares       = 0;
-  uint32_t difficulty   = 0;
-  uint32_t accepted     = 0;
-  uint32_t rejected     = 0;
-  float    last_ping_ms = 0.0f;
-  // ★追加: SHA1 演出用（実値）スナップショット
-  bool     work_valid      = false;
-  uint32_t work_nonce      = 0;
-  uint32_t work_max_nonce  = 0;
-  uint32_t work_diff       = 0;
-  uint8_t  work_out[20]    = {0};    // out[20] の生バイト
-  char     work_seed[41]   = {0};    // prev（最大40）
+  float    hashrate_kh  = 0.0f;     // 実時間で割った値
+  float    compute_kh   = 0.0f;     // ★追加: 計算時間（yield / 一時停止を除く）で割った値
+  uint32_t difficulty   = 0;    // いま解いているジョブ
+  float    last_solve_ms = 0.0f;  // ★追加: 直近のジョブを解くのにかかった時間（停めていた分を除く）
+  uint32_t hashes       = 0;    // ★追加: 回した数の累計（制御ポイントごとにワーカーが足す。I/O タスクは差分を読む）
+  // ★追加: SHA1 演出用（実値）スナップショット（seqlock）
+  DucoWorkSnap work;
 };
 
-static DucoThreadStats   g_thr[DUCO_MINER_THREADS];
+static DucoThreadStats   g_thr[DUCO_MINER_MAX_THREADS];
+static volatile uint8_t  g_hrPolicy = MC_DUCO_HASHRATE_POLICY;   // ★追加: MiningHashratePolicy
 static SemaphoreHandle_t g_shaMutex = nullptr;
 
-// ★追加：スナップショット共有の排他用（duco_task / solver / updateMiningSummary で共通）
-static portMUX_TYPE g_statsMux = portMUX_INITIALIZER_UNLOCKED;
+// ---- work スナップショットの seqlock ----
+static inline void work_begin_(DucoWorkSnap& w) {
+  __atomic_store_n(&w.seq, w.seq + 1, __ATOMIC_RELAXED);   // 奇数 = 書き込み中
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static inline void work_end_(DucoWorkSnap& w) {
+  __atomic_store_n(&w.seq, w.seq + 1, __ATOMIC_RELEASE);   // 偶数 = 読んでよい
+}
+
+// 書き込みと重なったら読み直す。何度やっても取れなければ false（今回は諦める）
+static bool work_read_(const DucoWorkSnap& w, DucoWorkData& out) {
+  for (int tries = 0; tries < 8; ++tries) {
+    const uint32_t s1 = __atomic_load_n(&w.seq, __ATOMIC_ACQUIRE);
+    if (s1 & 1u) continue;
+    memcpy(&out, (const void*)&w.d, sizeof(out));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&w.seq, __ATOMIC_RELAXED) == s1) return true;
+  }
+  return false;
+}
+
+// ---- ★追加: 演出用サンプルは UI からの要求があったときだけ作る ----
+// UI が requestMiningWorkSample() で g_workReq を進め、次に制御ポイントに来た
+// solver（どれか1スレッド）が CAS で g_workServed を追いつかせてから自分の work に書く。
+// 要求が無ければ solver はスナップショットの仕事を一切しない（画面 OFF / スタックチャン画面など）。
+static volatile uint32_t g_workReq    = 0;
+static uint32_t          g_workServed = 0;
+
+// 未処理の要求があればそれを引き受ける（1要求につき true を返すのは1スレッドだけ）
+static inline bool work_take_request_(uint32_t& req) {
+  req = __atomic_load_n(&g_workReq, __ATOMIC_ACQUIRE);
+  uint32_t served = __atomic_load_n(&g_workServed, __ATOMIC_RELAXED);
+  if (req == served) return false;
+  return __atomic_compare_exchange_n(&g_workServed, &served, req, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+
+// 新しいジョブの“お題”（prev + difficulty）を公開し、digest は一旦無効に
+static void work_set_job_(DucoThreadStats& me, const char* seed, uint32_t diff) {
+  work_begin_(me.work);
+  me.work.d.diff  = diff;
+  me.work.d.valid = false;
+  strncpy(me.work.d.seed, seed, 40);
+  me.work.d.seed[40] = '\0';
+  work_end_(me.work);
+}
 
 static String   g_node_name;
-static String   g_host;
-static uint16_t g_port = 0;
 static uint32_t g_acc_all = 0, g_rej_all = 0;
 static String   g_status = "boot";
 static bool     g_any_connected = false;
@@ -70,11 +187,41 @@ static char     g_chip_id[16] = {0};
 static int      g_walletid = 0;
 // ★追加: プールの診断メッセージ（UIに渡す用）
 static String   g_poolDiagText = "";
+static String   g_kernelDiag   = "";   // ★追加: カーネル自己テストの失敗（プール側のエラーが無いときに poolDiag へ）
 
 // ===== mining control knobs (for attention mode etc.) =====
-static volatile uint8_t  g_mining_active_threads = DUCO_MINER_THREADS; // 0..DUCO_MINER_THREADS
+static uint8_t           g_miner_threads = MC_MINER_THREADS;  // ★追加: 起動したワーカー数（startMiner で確定）
+static volatile uint8_t  g_mining_active_threads = DUCO_MINER_MAX_THREADS; // 0..g_miner_threads
 static volatile uint16_t g_yield_every = 1024;   // power-of-two recommended
 static volatile uint8_t  g_yield_ms    = 1;      // delay in ms at yield points
+static volatile bool     g_coop_mode   = (MC_DUCO_COOP != 0);  // ★追加: 1ジョブを全ワーカーで分担
+
+// ★追加: スレッド idx が無効な間、有効になる（EVT_ENABLED）まで最大 timeoutMs 待つ。
+// 有効になって起きた場合は true（再開レイテンシを記録）
+static bool waitEnabled_(int idx, uint32_t timeoutMs) {
+  if (idx < (int)g_mining_active_threads) return true;
+  const EventBits_t bit = EVT_ENABLED(idx);
+  const EventBits_t got = xEventGroupWaitBits(ctl_events_(), bit, pdFALSE, pdTRUE,
+                                              pdMS_TO_TICKS(timeoutMs));
+  if ((got & bit) && idx < (int)g_mining_active_threads) {
+    note_resumed_();
+    return true;
+  }
+  return false;
+}
+
+static void ctl_sync_bits_() {
+  if (!g_ctlEvents) return;
+  EventBits_t set = 0, clr = 0;
+  if (g_miningPaused) clr |= EVT_RUN;
+  else                set |= EVT_RUN;
+  for (int i = 0; i < (int)g_miner_threads; ++i) {
+    if (i < (int)g_mining_active_threads) set |= EVT_ENABLED(i);
+    else                                  clr |= EVT_ENABLED(i);
+  }
+  if (clr) xEventGroupClearBits(g_ctlEvents, clr);
+  if (set) xEventGroupSetBits(g_ctlEvents, set);
+}
 
 static inline uint16_t normalize_pow2(uint16_t v) {
   if (v < 8) v = 8;
@@ -83,27 +230,29 @@ static inline uint16_t normalize_pow2(uint16_t v) {
   return p;
 }
 
-// Solver abort marker (distinct from "not found")
-static const uint32_t DUCO_ABORTED = UINT32_MAX - 1;
+// Solver abort marker (distinct from "not found") — duco_s1.h の約束と同じ値
+static const uint32_t DUCO_ABORTED = DUCO_S1_ABORTED;
 
 
 
 // ---------------- プール情報取得 ----------------
-static bool duco_get_pool() {
+// ★変更: 結果は out に返すだけ（今使うノードは I/O タスクが pool_apply_ で切り替える）。
+// 失敗したら diag に UI 向けの理由
+static bool duco_fetch_pool_(DucoPoolEntry& out, const char*& diag) {
   WiFiClientSecure s;
   s.setInsecure();
   HTTPClient http;
   http.setTimeout(7000);
 
   if (!http.begin(s, DUCO_POOL_URL)) {
-    g_poolDiagText = "Cannot connect to the pool info server.";
+    diag = "Cannot connect to the pool info server.";
     return false;
   }
 
   int code = http.GET();
   if (code != HTTP_CODE_OK) {
     http.end();
-    g_poolDiagText = "Pool info server responded with an error.";
+    diag = "Pool info server responded with an error.";
     return false;
   }
 
@@ -112,45 +261,69 @@ static bool duco_get_pool() {
 
   JsonDocument doc;  // ArduinoJson v7
   if (deserializeJson(doc, body)) {
-    g_poolDiagText = "Failed to parse pool info response.";
+    diag = "Failed to parse pool info response.";
     return false;
   }
 
-  g_node_name = doc["name"].as<String>();
-  g_host      = doc["ip"].as<String>();
-  g_port      = (uint16_t)doc["port"].as<int>();
+  DucoPoolEntry e;
+  strncpy(e.name, doc["name"] | "", sizeof(e.name) - 1);
+  strncpy(e.host, doc["ip"] | "", sizeof(e.host) - 1);
+  e.port       = (uint16_t)doc["port"].as<int>();
+  e.fetched_at = duco_pool_now_s();
 
-  mc_logf("[DUCO] Pool: %s (%s:%u)", g_node_name.c_str(),
-          g_host.c_str(), (unsigned)g_port);
+  mc_logf("[DUCO] Pool: %s (%s:%u)", e.name, e.host, (unsigned)e.port);
 
-  if (g_port != 0 && g_host.length()) {
+  if (duco_pool_entry_valid(e)) {
     // ここでは「Pool自体の情報は取得OK」
-    g_poolDiagText = "";
+    out = e;
     return true;
   }
 
-  g_poolDiagText = "Pool info response is incomplete.";
+  diag = "Pool info response is incomplete.";
   return false;
 }
 
+// ---- ★追加: プールノードの選び方 ----
+// 起動時は LittleFS に覚えておいた「最後に繋がったノード」ですぐ繋ぎ始め、
+// getPool（HTTPS・最大 7 秒）は DucoPool タスクが裏で取ってくる。
+// 取れた結果に乗り換えるのは、キャッシュが古い（MC_DUCO_POOL_CACHE_MAX_AGE_S）か
+// 今のノードに続けて繋がらない（MC_DUCO_POOL_FAIL_MAX）ときだけ。
+// ★追加: getPool / pool_nodes / キャッシュのノードは候補表（duco_pool_select）に入れ、
+// DucoPool タスクが MC_DUCO_POOL_PROBE_MS ごとに測る。測り終えたら I/O タスクが
+// 一番良い候補と今のノードを比べ、十分に良ければ乗り換える。
+// g_poolCur / g_node_name（と duco_io_set_pool）を書くのは I/O タスク（起動前は startMiner）だけ。
+enum DucoPoolSource : uint8_t {
+  POOL_SRC_NONE = 0,
+  POOL_SRC_CACHE,   // LittleFS のキャッシュ
+  POOL_SRC_FETCH,   // この起動で getPool から取った
+  POOL_SRC_PROBE,   // ★追加: 候補を測って選び直した
+};
 
-// ---------- util: u32_to_dec（固定バッファへ10進変換） ----------
-static inline int u32_to_dec(char* dst, uint32_t v) {
-  if (v == 0) {
-    dst[0] = '0';
-    return 1;
-  }
-  char tmp[10];
-  int n = 0;
-  while (v) {
-    tmp[n++] = char('0' + (v % 10));
-    v /= 10;
-  }
-  for (int i = 0; i < n; ++i) {
-    dst[i] = tmp[n - 1 - i];
-  }
-  return n;
-}
+static DucoPoolEntry  g_poolCur;                     // 今使っているノード
+static DucoPoolSource g_poolSrc        = POOL_SRC_NONE;
+static bool           g_poolUnsaved    = false;      // getPool のノードに繋がったらキャッシュに書く
+static uint8_t        g_poolFailStreak = 0;          // 今のノードへの接続が続けて失敗した数
+static bool           g_poolFailed     = false;      // 次の getPool 結果には必ず乗り換える
+
+// ★追加: 候補表（DucoPool タスクが測った結果を書き、I/O タスクがシェアの結果を書く）。
+// 番号は追い出されない限り変わらない（今のノード g_poolCurIdx は追い出さない）
+static DucoPoolSel       g_poolSel;
+static int               g_poolCurIdx    = -1;
+static portMUX_TYPE      g_poolSelMux    = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint32_t g_poolProbeSeq  = 0;       // 測り終えるたびに +1
+static volatile bool     g_poolWantFetch = false;   // I/O タスク → DucoPool タスク：getPool を取り直して
+static volatile bool     g_poolProbeNow  = false;   // すぐ測って（SET pool_nodes など）
+// 設定の pool_nodes の写し（g_poolSelMux で守る）。mc_config_store の String は
+// ループタスクが SET で書き換えるので、DucoPool タスクはこちらだけを読む
+static char              g_poolNodes[(DUCO_POOL_MAX_CANDS - 2) * (sizeof(((DucoPoolCand*)0)->host) + 7)] = {0};
+
+// DucoPool タスク → I/O タスク（ready の間は書き手は触らない）
+static DucoPoolEntry        g_poolFresh;
+static volatile bool        g_poolFreshReady = false;
+static const char* volatile g_poolFetchDiag  = nullptr;   // getPool の失敗理由（成功したら nullptr）
+static TaskHandle_t         g_poolTask       = nullptr;
+
+static volatile uint32_t g_firstJobMs = 0;   // ★追加: 起動から最初のジョブが届くまで [ms]（0 = まだ）
 
 // ---------- SHA1 helper (mbedTLS) ----------
 static inline void sha1_calc(const unsigned char* data,
@@ -163,354 +336,1228 @@ static inline void sha1_calc(const unsigned char* data,
 #endif
 }
 
-// ---------- solver: duco_s1（mbedTLS SHA1 + 固定バッファ） ----------
-// ★変更: stats を渡して「いま計算している out/nonce」をスナップショットする
-static uint32_t duco_solve_duco_s1(const String& seed,
-                                  const unsigned char* expected20,
-                                  uint32_t difficulty,
-                                  uint32_t& hashes_done,
-                                  DucoThreadStats* stats) {
-  const uint32_t maxNonce = difficulty * 100U;
-  hashes_done = 0;
+// ---------- solver: mbedTLS 版（seed が 40 桁でないとき用の汎用パス） ----------
+// duco_s1_scan と同じ約束（見つかった nonce / NOT_FOUND / ABORTED）で [first, last] を走査
+static uint32_t scan_mbedtls_(const char* seed, int seed_len,
+                              const unsigned char* expected20,
+                              uint32_t first, uint32_t last,
+                              uint32_t& hashes, DucoS1Control& ctl) {
+  hashes = 0;
+  if (first > last) return DUCO_S1_NOT_FOUND;
 
   char buf[96];
-  int seed_len = seed.length();
   if (seed_len > (int)sizeof(buf) - 12) seed_len = sizeof(buf) - 12;
-  memcpy(buf, seed.c_str(), seed_len);
+  memcpy(buf, seed, seed_len);
   char* nonce_ptr = buf + seed_len;
+  size_t nlen = (size_t)duco_s1_u32_to_dec(nonce_ptr, first);
 
   unsigned char out[20];
+  uint32_t untilPoll = ctl.every;
+  for (uint32_t nonce = first;; ++nonce) {
+    sha1_calc((const unsigned char*)buf, seed_len + nlen, out);
+    hashes++;
+    if (memcmp(out, expected20, 20) == 0) return nonce;
 
-// thread index (0/1..) for control checks
-const int tidx = (stats) ? int(stats - g_thr) : -1;
-if (tidx >= 0 && tidx >= (int)g_mining_active_threads) {
-  return DUCO_ABORTED;
+    if (--untilPoll == 0) {
+      if (ctl.poll && !ctl.poll(ctl, nonce)) return DUCO_S1_ABORTED;
+      untilPoll = ctl.every ? ctl.every : 1;
+    }
+    if (nonce == last) break;
+    duco_s1_nonce_inc(nonce_ptr, nlen);
+  }
+  return DUCO_S1_NOT_FOUND;
 }
 
-  for (uint32_t nonce = 0; nonce <= maxNonce; ++nonce) {
-    // ---- ★ Pause: keep current JOB, stop only the CPU-heavy loop ----
-    // When paused, we yield here and resume from the same nonce (no disconnect / no job drop).
-    if (g_miningPaused) {
-      waitWhilePaused_();
-      // If this thread got disabled while paused, abort cleanly.
-      if (tidx >= 0 && tidx >= (int)g_mining_active_threads) {
-        return DUCO_ABORTED;
-      }
-    }
+// 同じ mbedTLS 版を DucoS1Job だけの約束で（カーネル登録簿 / キャリブレーション用）
+static uint32_t scan_mbedtls_job_(const DucoS1Job& job, uint32_t first, uint32_t last,
+                                  uint32_t& hashes, DucoS1Control& ctl) {
+  char    seed[DUCO_S1_SEED_LEN];
+  uint8_t expected[20];
+  duco_s1_job_seed(job, seed);
+  duco_s1_job_expected(job, expected);
+  return scan_mbedtls_(seed, (int)DUCO_S1_SEED_LEN, expected, first, last, hashes, ctl);
+}
+
+// ---------- solver: カーネル選択 ----------
+// ★追加: startMiner() で決める。未選択なら duco_s1_scan
+static const DucoS1Kernel* g_kernel = nullptr;
+
+// 自動選択を切ったとき / 全滅したときに使う固定カーネル（config.h）
+static const char* default_kernel_name_() {
+#if MC_DUCO_S1_VECTOR
+  return duco_s1_vector_backend<MC_DUCO_S1_LANES>();
+#elif MC_DUCO_S1_LANES == 4
+  return "il4";
+#elif MC_DUCO_S1_LANES == 2
+  return "il2";
+#else
+  return "scalar";
+#endif
+}
+
+static uint64_t calib_now_us_() {
+  return (uint64_t)esp_timer_get_time();
+}
+
+// 登録済みの全カーネルを同じ合成ジョブで測り、正しく解けた中で一番速いものを使う
+static void select_kernel_() {
+  duco_s1_kernel_register("mbedtls", scan_mbedtls_job_);
+  const DucoS1Kernel* fixed = duco_s1_kernel_find(default_kernel_name_());
+  if (!fixed) fixed = duco_s1_kernel_find("scalar");
+
+#if MC_DUCO_S1_AUTOSELECT
+  DucoS1CalibResult res[DUCO_S1_MAX_KERNELS];
+  size_t n = 0;
+  const DucoS1Kernel* best = duco_s1_calibrate(MC_DUCO_S1_CALIB_HASHES, calib_now_us_,
+                                               res, DUCO_S1_MAX_KERNELS, n);
+  for (size_t i = 0; i < n; ++i) {
+    mc_logf("[DUCO] kernel %-8s %s %8.1f H/s (%u hashes, %u us)",
+            res[i].kernel->name, res[i].ok ? "ok  " : "FAIL",
+            res[i].hps, (unsigned)res[i].hashes, (unsigned)res[i].us);
+  }
+  g_kernel = best ? best : fixed;
+#else
+  g_kernel = fixed;
+#endif
+
+  mc_logf("[DUCO] kernel selected: %s (cpu=%u MHz, autoselect=%d)",
+          g_kernel ? g_kernel->name : "scalar",
+          (unsigned)getCpuFrequencyMhz(), (int)MC_DUCO_S1_AUTOSELECT);
+}
+
+// ★追加: 選んだカーネルを既知解テストにかける。
+// 外れたらそのカーネルは使わず、参照実装（mbedTLS）に戻して poolDiag で知らせる。
+static void selftest_kernel_() {
+  if (!g_kernel) return;
+
+  DucoS1KatFailure f;
+  if (duco_s1_kat_run(g_kernel->scan, &f)) {
+    mc_logf("[DUCO] kernel %s self-test ok (%u vectors)",
+            g_kernel->name, (unsigned)duco_s1_kat_count());
+    return;
+  }
+
+  mc_logf("[DUCO] kernel %s self-test FAILED: vector=%d %s got=%u hashes=%u/%u",
+          g_kernel->name, f.index, f.negative ? "(miss window)" : "(hit window)",
+          (unsigned)f.got, (unsigned)f.hashes, (unsigned)f.want);
+  g_kernelDiag = String("Hash kernel ") + g_kernel->name + " failed self-test; using mbedtls.";
+
+  const DucoS1Kernel* ref = duco_s1_kernel_find("mbedtls");
+  if (!ref || ref == g_kernel) return;
+  g_kernel = ref;
+
+  if (!duco_s1_kat_run(ref->scan, &f)) {
+    // 参照実装まで外れるなら SHA1 そのものが怪しい。止めはしないが目立たせる
+    mc_logf("[DUCO] kernel mbedtls self-test FAILED too: vector=%d", f.index);
+    g_kernelDiag = "Hash self-test failed (mbedtls too).";
+  }
+}
+
+// ---------- solver: 制御ポイント（yield / pause / 停止 / 演出用スナップショット） ----------
+struct SolverPoll {
+  DucoThreadStats* stats;
+  int              tidx;       // thread index (0/1..) for control checks
+  uint32_t         maxNonce;
+  const DucoS1Job* job;        // nullptr なら mbedTLS パス
+  const char*      seed;
+  int              seedLen;
+  uint32_t         coopGen = 0; // ★協調モードで分担中のジョブ世代（0 = 単独）
+  // ★追加: ジョブをくれた接続の世代。I/O タスクが接続を閉じて変わったら打ち切る
+  const uint32_t*  connGen     = nullptr;
+  uint32_t         connGenWant = 0;
+  // ★追加: yield / 一時停止 / 協調の待ちで止まっていた時間をここに足す（計算時間 = 実時間 - これ）
+  uint32_t*        stallUs     = nullptr;
+  uint32_t         countNext   = 0;   // ★追加: stats->hashes に足し終えた次の nonce（solver_scan_ が first に合わせる）
+};
+
+static inline void stall_add_(const SolverPoll& sp, int64_t t0) {
+  if (sp.stallUs) *sp.stallUs += (uint32_t)(esp_timer_get_time() - t0);
+}
+
+// ★追加: next の手前まで回した分を stats->hashes に足す（ハッシュレートの時系列用）
+static inline void solver_count_(SolverPoll& sp, uint32_t next) {
+  if (!sp.stats || next <= sp.countNext) return;
+  __atomic_add_fetch(&sp.stats->hashes, next - sp.countNext, __ATOMIC_RELAXED);
+  sp.countNext = next;
+}
+
+// ---------- 協調モード: 1つのジョブの nonce 範囲を全ワーカーで分担 ----------
+// 接続を持つスレッド（オーナー = スレッド0）がジョブをここに公開し、
+// 他のワーカーは MC_DUCO_COOP_CHUNK ずつ nonce 範囲をもらって回す。
+// 最初に見つけたワーカーが found を書くと、他は次の制御ポイントで打ち切る。
+// 公開中の job / seed / expected は inflight > 0 の間は書き換えない（オーナーは閉じてから待つ）。
+struct CoopSlot {
+  uint32_t  gen       = 0;      // 公開のたびに +1（0 は未使用）
+  bool      open      = false;  // 配布中
+  bool      exhausted = false;  // 全 chunk を配り終えた
+  DucoS1Job job;
+  bool      fast      = false;  // false = mbedTLS パス（seed が 40 桁でない）
+  char      seed[81]  = {0};
+  int       seedLen   = 0;
+  uint8_t   expected[20] = {0};
+  uint32_t  difficulty = 0;
+  uint32_t  maxNonce  = 0;
+  uint32_t  next      = 0;      // 次に配る chunk の先頭
+  uint32_t  found     = DUCO_S1_NOT_FOUND;
+  uint32_t  hashes    = 0;      // 全ワーカーの合計
+  uint8_t   inflight  = 0;      // chunk を処理中のワーカー数
+  // 途中で止められたワーカーが返した残り範囲（次の claim で優先して配る）
+  uint32_t  retFirst[DUCO_MINER_MAX_THREADS] = {0};
+  uint32_t  retLast[DUCO_MINER_MAX_THREADS]  = {0};
+  uint8_t   retCount  = 0;
+};
+
+static CoopSlot     g_coop;
+static portMUX_TYPE g_coopMux = portMUX_INITIALIZER_UNLOCKED;
+
+static inline bool coop_active_() {
+  return g_coop_mode && g_mining_active_threads > 1;
+}
+
+// 協調ジョブが打ち切られたか（誰かが見つけた / オーナーが閉じた / 次のジョブに変わった）。
+// solver の制御ポイントからは g_coopMux の外で呼ぶので、各フィールドは atomic に読む
+static inline bool coop_cancelled_(uint32_t gen) {
+  return __atomic_load_n(&g_coop.gen, __ATOMIC_ACQUIRE) != gen ||
+         !__atomic_load_n(&g_coop.open, __ATOMIC_ACQUIRE) ||
+         __atomic_load_n(&g_coop.found, __ATOMIC_ACQUIRE) != DUCO_S1_NOT_FOUND;
+}
+
+// 見つかった nonce / 処理中の chunk 数（g_coopMux の外から読むとき）
+static inline uint32_t coop_found_() {
+  portENTER_CRITICAL(&g_coopMux);
+  const uint32_t f = g_coop.found;
+  portEXIT_CRITICAL(&g_coopMux);
+  return f;
+}
+
+static inline uint8_t coop_inflight_() {
+  portENTER_CRITICAL(&g_coopMux);
+  const uint8_t n = g_coop.inflight;
+  portEXIT_CRITICAL(&g_coopMux);
+  return n;
+}
+
+// まだ配る範囲が残っているか（g_coopMux 内で呼ぶ）
+static inline bool coop_has_work_() {
+  return !g_coop.exhausted || g_coop.retCount > 0;
+}
+
+// chunk を1つもらう。もらえたら inflight を増やして true
+static bool coop_claim_(uint32_t gen, uint32_t& first, uint32_t& last) {
+  bool ok = false;
+  portENTER_CRITICAL(&g_coopMux);
+  if (!coop_cancelled_(gen) && g_coop.retCount > 0) {
+    --g_coop.retCount;
+    first = g_coop.retFirst[g_coop.retCount];
+    last  = g_coop.retLast[g_coop.retCount];
+    g_coop.inflight++;
+    ok = true;
+  } else if (!coop_cancelled_(gen) && !g_coop.exhausted) {
+    first = g_coop.next;
+    const uint32_t span = MC_DUCO_COOP_CHUNK - 1;
+    last = (g_coop.maxNonce - first > span) ? first + span : g_coop.maxNonce;
+    if (last == g_coop.maxNonce) g_coop.exhausted = true;
+    else                         g_coop.next = last + 1;
+    g_coop.inflight++;
+    ok = true;
+  }
+  portEXIT_CRITICAL(&g_coopMux);
+  return ok;
+}
 
-    int nlen = u32_to_dec(nonce_ptr, nonce);
+// chunk [first, last] の結果を返す（見つけていれば最初の1つだけが採用される）。
+// まだ見つかっていないのに止められた（disable / オーナーが閉じた）場合は、回していない残りを返す。
+// 配布中なら次の claim で配り直し、閉じた後ならオーナーがジョブを停める位置に使う（coop_unsearched_）
+static void coop_release_(uint32_t gen, uint32_t first, uint32_t last,
+                          uint32_t hashes, uint32_t result) {
+  portENTER_CRITICAL(&g_coopMux);
+  if (g_coop.gen == gen) {
+    g_coop.hashes += hashes;
+    if (result == DUCO_S1_ABORTED && g_coop.found == DUCO_S1_NOT_FOUND &&
+        hashes <= last - first && g_coop.retCount < DUCO_MINER_MAX_THREADS) {
+      g_coop.retFirst[g_coop.retCount] = first + hashes;
+      g_coop.retLast[g_coop.retCount]  = last;
+      g_coop.retCount++;
+    }
+    if (result != DUCO_S1_NOT_FOUND && result != DUCO_S1_ABORTED &&
+        g_coop.found == DUCO_S1_NOT_FOUND) {
+      g_coop.found = result;
+    }
+    if (g_coop.inflight) g_coop.inflight--;
+  }
+  portEXIT_CRITICAL(&g_coopMux);
+}
 
-    // 修正案：Mutexを外してパフォーマンス増加を期待
-    // if (g_shaMutex) xSemaphoreTake(g_shaMutex, portMAX_DELAY); // 削除
+// nonce の SHA1 を out に（演出用。区切りごとに1回だけなのでコストは無視できる）
+static void solver_digest_(const SolverPoll& sp, uint32_t nonce, unsigned char out[20]) {
+  char buf[96];
+  int  seed_len = sp.seedLen;
+  if (seed_len > (int)sizeof(buf) - 12) seed_len = sizeof(buf) - 12;
+  memcpy(buf, sp.seed, seed_len);
+  const int nlen = duco_s1_u32_to_dec(buf + seed_len, nonce);
+  if (sp.job) {
+    duco_s1_hash(*sp.job, buf + seed_len, (size_t)nlen, out);
+  } else {
     sha1_calc((const unsigned char*)buf, seed_len + nlen, out);
-    // if (g_shaMutex) xSemaphoreGive(g_shaMutex);               // 削除
-
-    hashes_done++;
-
-    // ★一致チェック（見つかったら即返す）
-    if (memcmp(out, expected20, 20) == 0) {
-      if (stats) {
-        portENTER_CRITICAL(&g_statsMux);
-        stats->work_nonce     = nonce;
-        stats->work_max_nonce = maxNonce;
-        memcpy(stats->work_out, out, 20);
-        stats->work_valid = true;
-        portEXIT_CRITICAL(&g_statsMux);
+  }
+}
+
+static void solver_snapshot_(const SolverPoll& sp, uint32_t stamp,
+                             uint32_t nonce, const unsigned char out[20]) {
+  if (!sp.stats) return;
+  DucoWorkSnap& w = sp.stats->work;
+  work_begin_(w);
+  w.d.stamp     = stamp;
+  w.d.nonce     = nonce;
+  w.d.max_nonce = sp.maxNonce;
+  memcpy(w.d.out, out, 20);
+  w.d.valid = true;
+  work_end_(w);
+}
+
+static bool solver_poll_(DucoS1Control& ctl, uint32_t nonce) {
+  SolverPoll& sp = *(SolverPoll*)ctl.user;
+  solver_count_(sp, nonce + 1);   // nonce は最後に試した値
+
+  // ★変更: UI から要求が来ているときだけ「いま計算してる値」をスナップショット
+  uint32_t req;
+  if (sp.stats && work_take_request_(req)) {
+    unsigned char out[20];
+    solver_digest_(sp, nonce, out);
+    solver_snapshot_(sp, req, nonce, out);
+  }
+
+  // If this thread got disabled mid-job, abort cleanly.
+  if (sp.tidx >= 0 && sp.tidx >= (int)g_mining_active_threads) return false;
+
+  // ★協調モード: 他のワーカーが見つけた / 配布が閉じられたらこの chunk は打ち切り
+  if (sp.coopGen && coop_cancelled_(sp.coopGen)) return false;
+
+  // ★追加: ジョブの接続が切れた（submit 先が無い）なら回しても無駄
+  if (sp.connGen && __atomic_load_n(sp.connGen, __ATOMIC_RELAXED) != sp.connGenWant) return false;
+
+  const int64_t stallT0 = esp_timer_get_time();
+  uint8_t dms = g_yield_ms;
+  if (dms) vTaskDelay(pdMS_TO_TICKS(dms));
+
+  // ---- ★ Pause: keep current JOB, stop only the CPU-heavy loop ----
+  // When paused, we yield here and resume from the next nonce (no disconnect / no job drop).
+  if (g_miningPaused) {
+    waitWhilePaused_();
+    stall_add_(sp, stallT0);
+    // If this thread got disabled while paused, abort cleanly.
+    if (sp.tidx >= 0 && sp.tidx >= (int)g_mining_active_threads) return false;
+  } else if (dms) {
+    stall_add_(sp, stallT0);
+  }
+
+  ctl.every = g_yield_every;
+  return true;
+}
+
+// [first, last] を選ばれたカーネル（seed が 40 桁でなければ mbedTLS）で回す
+static uint32_t solver_scan_(SolverPoll& sp, const unsigned char* expected20,
+                             uint32_t first, uint32_t last, uint32_t& hashes) {
+  DucoS1Control ctl;
+  ctl.every = g_yield_every;
+  ctl.poll  = solver_poll_;
+  ctl.user  = (void*)&sp;
+  sp.countNext = first;
+
+  uint32_t found;
+  if (!sp.job) {
+    found = scan_mbedtls_(sp.seed, sp.seedLen, expected20, first, last, hashes, ctl);
+  } else {
+    const DucoS1ScanFn scan = g_kernel ? g_kernel->scan : duco_s1_scan;
+    found = scan(*sp.job, first, last, hashes, ctl);
+  }
+  solver_count_(sp, first + hashes);   // 最後の制御ポイントより後の分
+  return found;
+}
+
+// ★追加: まだ誰も回していない一番小さい nonce（配っていない先頭と、返された残りの先頭の小さい方）。
+// 全部回し終えていれば maxNonce + 1。g_coopMux 内で、inflight が 0 になってから呼ぶ
+static uint32_t coop_unsearched_() {
+  uint32_t low = g_coop.exhausted ? g_coop.maxNonce + 1 : g_coop.next;
+  for (uint8_t i = 0; i < g_coop.retCount; ++i) {
+    if (g_coop.retFirst[i] < low) low = g_coop.retFirst[i];
+  }
+  return low;
+}
+
+// ★協調モードのオーナー側: ジョブを公開し、自分も chunk をもらって回す。
+// 戻り値は duco_solve_duco_s1 と同じ。hashes_done は全ワーカーの合計、own は自分の分。
+// ★追加: DUCO_ABORTED のときは next に続きを始める nonce（coop_unsearched_）を返す
+static uint32_t coop_solve_(SolverPoll& sp, const unsigned char* expected20,
+                            uint32_t difficulty, uint32_t firstNonce,
+                            uint32_t& hashes_done, uint32_t& own, uint32_t& next) {
+  portENTER_CRITICAL(&g_coopMux);
+  g_coop.gen = g_coop.gen + 1 ? g_coop.gen + 1 : 1;
+  g_coop.fast = (sp.job != nullptr);
+  if (sp.job) g_coop.job = *sp.job;
+  g_coop.seedLen = (sp.seedLen < (int)sizeof(g_coop.seed) - 1) ? sp.seedLen
+                                                               : (int)sizeof(g_coop.seed) - 1;
+  memcpy(g_coop.seed, sp.seed, g_coop.seedLen);
+  g_coop.seed[g_coop.seedLen] = '\0';
+  memcpy(g_coop.expected, expected20, 20);
+  g_coop.difficulty = difficulty;
+  g_coop.maxNonce   = sp.maxNonce;
+  g_coop.next       = firstNonce;
+  g_coop.exhausted  = (firstNonce > sp.maxNonce);
+  g_coop.found      = DUCO_S1_NOT_FOUND;
+  g_coop.hashes     = 0;
+  g_coop.inflight   = 0;
+  g_coop.retCount   = 0;
+  g_coop.open       = true;
+  const uint32_t gen = g_coop.gen;
+  portEXIT_CRITICAL(&g_coopMux);
+
+  sp.coopGen = gen;
+  own = 0;
+  bool stopped = false;  // このスレッドが止められた（disable）
+
+  uint32_t first, last;
+  for (;;) {
+    while (coop_claim_(gen, first, last)) {
+      uint32_t h = 0;
+      const uint32_t r = solver_scan_(sp, expected20, first, last, h);
+      own += h;
+      coop_release_(gen, first, last, h, r);
+      if (r == DUCO_ABORTED) {
+        stopped = (coop_found_() == DUCO_S1_NOT_FOUND);
+        break;
       }
-      return nonce;
+      if (r != DUCO_S1_NOT_FOUND) break;
     }
+    if (stopped || coop_found_() != DUCO_S1_NOT_FOUND) break;
+
+    // 他のワーカーが処理中の chunk を待つ（返された残りがあればまた自分で回す）
+    bool busy;
+    portENTER_CRITICAL(&g_coopMux);
+    busy = g_coop.inflight > 0 || coop_has_work_();
+    portEXIT_CRITICAL(&g_coopMux);
+    if (!busy) break;
+    if (sp.tidx >= 0 && sp.tidx >= (int)g_mining_active_threads) {
+      stopped = true;
+      break;
+    }
+    const int64_t t0 = esp_timer_get_time();
+    vTaskDelay(pdMS_TO_TICKS(1));
+    stall_add_(sp, t0);
+  }
 
-    // ★一定間隔で「いま計算してる値」をスナップショット + yield + control point
-    uint16_t every = g_yield_every;
-    uint32_t mask  = (every >= 1) ? (uint32_t)(every - 1) : 0xFFFFFFFFu;
-    if ((nonce & mask) == 0) {
-      if (stats) {
-        portENTER_CRITICAL(&g_statsMux);
-        stats->work_nonce     = nonce;
-        stats->work_max_nonce = maxNonce;
-        memcpy(stats->work_out, out, 20);
-        stats->work_valid = true;
-        portEXIT_CRITICAL(&g_statsMux);
-      }
+  portENTER_CRITICAL(&g_coopMux);
+  g_coop.open = false;
+  portEXIT_CRITICAL(&g_coopMux);
+  const int64_t t0 = esp_timer_get_time();
+  while (coop_inflight_() > 0) vTaskDelay(pdMS_TO_TICKS(1));
+  stall_add_(sp, t0);
+
+  portENTER_CRITICAL(&g_coopMux);
+  hashes_done = g_coop.hashes;
+  const uint32_t found = g_coop.found;
+  next = coop_unsearched_();
+  portEXIT_CRITICAL(&g_coopMux);
+  // 止められても、残りが無ければ見つからなかったのと同じ
+  if (found == DUCO_S1_NOT_FOUND && stopped && next <= sp.maxNonce) return DUCO_ABORTED;
+  return found;
+}
 
-      // If this thread got disabled mid-job, abort cleanly.
-      if (tidx >= 0 && tidx >= (int)g_mining_active_threads) {
-        return DUCO_ABORTED;
-      }
+// ★協調モードのヘルパー側（接続を持たないワーカー）:
+// 公開中のジョブがあれば chunk をもらえる限り回す。無ければ少し待って戻る
+static void coop_help_(int idx, DucoThreadStats& me) {
+  uint32_t gen = 0;
+  portENTER_CRITICAL(&g_coopMux);
+  if (g_coop.open && coop_has_work_() && g_coop.found == DUCO_S1_NOT_FOUND) gen = g_coop.gen;
+  portEXIT_CRITICAL(&g_coopMux);
+  if (!gen) {
+    vTaskDelay(pdMS_TO_TICKS(5));
+    return;
+  }
+
+  uint32_t stallUs = 0;
+  SolverPoll sp;
+  sp.stats   = &me;
+  sp.tidx    = idx;
+  sp.coopGen = gen;
+  sp.stallUs = &stallUs;
+
+  unsigned long tStart = micros();
+  uint32_t total = 0;
+  bool first_chunk = true;
+  uint32_t first, last;
+  while (coop_claim_(gen, first, last)) {
+    // claim 中（inflight > 0）は g_coop のジョブ内容が固定されている
+    if (first_chunk) {
+      first_chunk = false;
+      sp.maxNonce = g_coop.maxNonce;
+      sp.job      = g_coop.fast ? &g_coop.job : nullptr;
+      sp.seed     = g_coop.seed;
+      sp.seedLen  = g_coop.seedLen;
+      me.difficulty = g_coop.difficulty;
+      work_set_job_(me, g_coop.seed, g_coop.difficulty);
+    }
 
-      uint8_t dms = g_yield_ms;
-      if (dms) vTaskDelay(pdMS_TO_TICKS(dms));
+    uint32_t h = 0;
+    const uint32_t r = solver_scan_(sp, g_coop.expected, first, last, h);
+    uint32_t req;
+    if (r != DUCO_S1_NOT_FOUND && r != DUCO_ABORTED && work_take_request_(req)) {
+      solver_snapshot_(sp, req, r, g_coop.expected);
     }
+    if (r != DUCO_S1_NOT_FOUND && r != DUCO_ABORTED) {
+      mc_logf("[DUCO-T%d] coop found nonce=%u", idx, (unsigned)r);
+    }
+    coop_release_(gen, first, last, h, r);
+    total += h;
+    if (r != DUCO_S1_NOT_FOUND) break;
+  }
+
+  if (total) {
+    const uint32_t runUs = (uint32_t)(micros() - tStart);
+    float sec = runUs / 1000000.0f;
+    if (sec <= 0) sec = 0.001f;
+    me.hashrate_kh = total / sec / 1000.0f;
+    float csec = (stallUs < runUs ? runUs - stallUs : 0) / 1000000.0f;
+    if (csec <= 0) csec = 0.001f;
+    me.compute_kh = total / csec / 1000.0f;
   }
-  return UINT32_MAX;
 }
 
+// ---------- solver: duco_s1 ----------
+// seed が 40 桁なら duco_s1.* のカーネル（seed 部分の前計算 + オドメータ + 早期棄却）。
+//   どのカーネルで回すかは startMiner() で選んだ g_kernel（duco_s1_kernels.h）
+// それ以外の seed は従来どおり mbedTLS で丸ごと計算する。
+// yield / pause / 停止 / スナップショットは g_yield_every ごとの制御ポイントでまとめて行う。
+// 協調モード（setMiningCooperative）では範囲を chunk に分けて他のワーカーと分担する。
+// hashes_done は全ワーカーの合計、own_hashes（任意）はこのスレッドが回した分。
+// ★追加: firstNonce から始める（停めたジョブの再開用）。DUCO_ABORTED のときは
+//   next_nonce（任意）に「次に試す nonce」を返す（協調モードでは範囲が飛び飛びなので、
+//   まだ誰も回していない一番小さい nonce。その先で回し終えた chunk は再開後にもう一度回す）
+// ★変更: stats を渡して「いま計算している out/nonce」をスナップショットする
+// ★追加: connGen（任意）が connGenWant から変わったら打ち切る（ジョブの接続が切れた）
+// ★追加: stall_us（任意）に yield / 一時停止 / 協調の待ちで止まっていた時間を足す
+static uint32_t duco_solve_duco_s1(const char* seed, int seedLen,
+                                  const unsigned char* expected20,
+                                  uint32_t difficulty,
+                                  uint32_t firstNonce,
+                                  uint32_t& hashes_done,
+                                  DucoThreadStats* stats,
+                                  const uint32_t* connGen = nullptr,
+                                  uint32_t connGenWant = 0,
+                                  uint32_t* own_hashes = nullptr,
+                                  uint32_t* next_nonce = nullptr,
+                                  uint32_t* stall_us = nullptr) {
+  const uint32_t maxNonce = difficulty * 100U;
+  hashes_done = 0;
+  if (own_hashes) *own_hashes = 0;
+  if (next_nonce) *next_nonce = firstNonce;
 
-// ---------------- Miner Task 本体 ----------------
-static void duco_task(void* pv) {
-  int idx = (int)(intptr_t)pv;
-  if (idx < 0 || idx >= DUCO_MINER_THREADS) idx = 0;
-  auto& me = g_thr[idx];
+  // thread index (0/1..) for control checks
+  const int tidx = (stats) ? int(stats - g_thr) : -1;
+  if (tidx >= 0 && tidx >= (int)g_mining_active_threads) {
+    return DUCO_ABORTED;
+  }
 
-  char tag[8];
-  snprintf(tag, sizeof(tag), "T%d", idx);
-  Serial.printf("[DUCO-%s] miner task start\n", tag);
+  // ★追加: seed 部分の message schedule / ラウンド 0..9 と target をジョブごとに前計算
+  DucoS1Job job;
+  const bool fast = duco_s1_prepare(job, seed, (size_t)seedLen);
+  if (fast) duco_s1_set_target(job, expected20);
+
+  SolverPoll sp;
+  sp.stats    = stats;
+  sp.tidx     = tidx;
+  sp.maxNonce = maxNonce;
+  sp.job      = fast ? &job : nullptr;
+  sp.seed     = seed;
+  sp.seedLen  = seedLen;
+  sp.connGen     = connGen;
+  sp.connGenWant = connGenWant;
+  sp.stallUs     = stall_us;
+
+  uint32_t found;
+  uint32_t own = 0;
+  if (coop_active_()) {
+    uint32_t next = firstNonce;
+    found = coop_solve_(sp, expected20, difficulty, firstNonce, hashes_done, own, next);
+    if (found == DUCO_ABORTED && next_nonce) *next_nonce = next;
+  } else {
+    found = solver_scan_(sp, expected20, firstNonce, maxNonce, hashes_done);
+    own   = hashes_done;
+    // カーネルは first から順に数えるので、止まった位置 = first + hashes
+    if (found == DUCO_ABORTED && next_nonce) *next_nonce = firstNonce + hashes_done;
+  }
+  if (own_hashes) *own_hashes = own;
+
+  // ★一致（見つかった nonce は expected そのものが digest）。これも要求があるときだけ
+  uint32_t req;
+  if (found != DUCO_S1_NOT_FOUND && found != DUCO_S1_ABORTED && work_take_request_(req)) {
+    solver_snapshot_(sp, req, found, expected20);
+  }
+  return found;
+}
+
+
+// ---------------- ★追加: プール I/O タスク ↔ 計算ワーカー ----------------
+// 接続の状態遷移・ジョブキュー・結果リングは duco_io（ホストの duco-mockpool でもそのまま回す）。
+// ここにあるのは duco_io から呼ばれる側（DucoIoHooks）と、WiFi / プールノード / tick を回す I/O タスク
+static TaskHandle_t g_ioTask = nullptr;
+
+// ---- ★追加: ジョブのトレース（duco_trace。書くのは I/O タスクだけ） ----
+static const char*      kTracePath   = "/duco_trace.bin";
+static volatile uint8_t g_traceWant  = MC_DUCO_TRACE;       // setMiningTrace の要求
+static uint8_t          g_traceMode  = MINING_TRACE_OFF;    // I/O タスクが反映した値
+static File             g_traceFile;
+static uint32_t         g_traceCount = 0;                   // 今回 ON にしてから書いた件数
+
+static const char* trace_mode_name_(uint8_t m) {
+  return m == MINING_TRACE_FS ? "fs" : (m == MINING_TRACE_SERIAL ? "serial" : "off");
+}
+
+// 要求が変わっていたら切り替える（I/O ループの頭で呼ぶ）
+static void trace_apply_mode_() {
+  const uint8_t want = g_traceWant;
+  if (want == g_traceMode) return;
+  if (g_traceFile) g_traceFile.close();
+  if (g_traceMode != MINING_TRACE_OFF) {
+    mc_logf("[TRACE] %s off (%u records)", trace_mode_name_(g_traceMode), (unsigned)g_traceCount);
+  }
+  g_traceMode  = MINING_TRACE_OFF;
+  g_traceCount = 0;
+  duco_io_set_trace(false);
+
+  if (want == MINING_TRACE_FS) {
+    if (LittleFS.begin(true)) g_traceFile = LittleFS.open(kTracePath, "a");
+    if (!g_traceFile) {
+      mc_logf("[TRACE] cannot open %s", kTracePath);
+      g_traceWant = MINING_TRACE_OFF;
+      return;
+    }
+    if (g_traceFile.size() == 0) {
+      uint8_t hdr[DUCO_TRACE_HDR_SIZE];
+      duco_trace_write_header(hdr);
+      g_traceFile.write(hdr, sizeof(hdr));
+    }
+  }
+  g_traceMode = want;
+  duco_io_set_trace(want != MINING_TRACE_OFF);
+  mc_logf("[TRACE] %s on", trace_mode_name_(want));
+}
+
+static void trace_emit_(const DucoTraceRecord& r) {
+  uint8_t rec[DUCO_TRACE_REC_SIZE];
+  duco_trace_encode(r, rec);
+
+  if (g_traceMode == MINING_TRACE_SERIAL) {
+    char hex[DUCO_TRACE_REC_SIZE * 2 + 1];
+    duco_trace_to_hex(rec, hex);
+    Serial.printf("@TRC %s\n", hex);
+  } else if (g_traceMode == MINING_TRACE_FS) {
+    // 上限を超えるなら止める（LittleFS を埋めない）
+    if (g_traceFile.size() + DUCO_TRACE_REC_SIZE > (size_t)MC_DUCO_TRACE_MAX_BYTES) {
+      mc_logf("[TRACE] %s is full", kTracePath);
+      g_traceWant = MINING_TRACE_OFF;
+      trace_apply_mode_();
+      return;
+    }
+    g_traceFile.write(rec, sizeof(rec));
+    if ((g_traceCount & 15) == 15) g_traceFile.flush();
+  }
+  ++g_traceCount;
+}
+
+// ---- ★追加: ハッシュレートの時系列（I/O タスクが 1 秒ごとに足す。読むのは UI / テレメトリ） ----
+// ★変更: 直近のジョブのハッシュレート（hashrate_kh）は解き終えるまで変わらず、一時停止中も残るので使わない。
+// 前の tick から実際に回した数（DucoThreadStats::hashes の差分）を経過時間で割る。止まっていれば 0
+static DucoHrSeries  g_hrSeries;
+static portMUX_TYPE  g_hrMux        = portMUX_INITIALIZER_UNLOCKED;
+static unsigned long g_hrLastMs     = 0;
+static uint32_t      g_hrLastHashes = 0;
+
+static void hr_series_tick_() {
+  const unsigned long now = millis();
+  if (g_hrLastMs && now - g_hrLastMs < 1000) return;
+  uint32_t hashes = 0;
+  for (int i = 0; i < (int)g_miner_threads; ++i) {
+    hashes += __atomic_load_n(&g_thr[i].hashes, __ATOMIC_RELAXED);
+  }
+  const unsigned long prevMs     = g_hrLastMs;
+  const uint32_t      prevHashes = g_hrLastHashes;
+  g_hrLastMs     = now;
+  g_hrLastHashes = hashes;
+  if (!prevMs) return;   // 最初の 1 回は基準を取るだけ
+  const float kh = (float)(uint32_t)(hashes - prevHashes) / (float)(now - prevMs);   // H/ms = kH/s
+  portENTER_CRITICAL(&g_hrMux);
+  duco_hr_series_add(g_hrSeries, (uint32_t)now, kh, MC_DUCO_HR_EWMA_S);
+  portEXIT_CRITICAL(&g_hrMux);
+}
+
+// ---- ★追加: 通算カウンタ（duco_lifetime。LittleFS の /duco_life.bin） ----
+// 起動時に startMiner が読み、I/O タスクが 1 秒ごとに「読んだ値 + この起動の分」を作って、
+// MC_DUCO_LIFE_FLUSH_S 経つか MC_DUCO_LIFE_FLUSH_SHARES シェア増えたら次のスロットに書く
+static const char*    kLifePath = "/duco_life.bin";
+static DucoLifeRecord g_lifeBase;              // 起動時に読んだ値（boots は +1 済み）
+static DucoLifeRecord g_lifeNow;               // g_lifeBase + この起動の分
+static DucoLifeRecord g_lifeWritten;           // 最後に書いた値
+static size_t         g_lifeSlot    = 0;       // 次に書くスロット
+static uint64_t       g_lifeMiningMs = 0;      // この起動でワーカーがハッシュを回していた時間 [ms]
+static uint32_t       g_lifeFlushes = 0;       // この起動で書いた回数
+static unsigned long  g_lifeFlushMs = 0;
+static unsigned long  g_lifeLastMs  = 0;
+static bool           g_lifeFs      = false;   // LittleFS に書ける
+static volatile bool  g_lifeFlushReq = false;  // すぐ書いて（requestMiningLifetimeFlush）
+static portMUX_TYPE   g_lifeMux     = portMUX_INITIALIZER_UNLOCKED;
+
+// r を次のスロットに書く（seq はここで振る）
+static bool life_write_(DucoLifeRecord& r) {
+  r.seq = g_lifeWritten.seq + 1;
+  if (!g_lifeFs) return false;
+  uint8_t rec[DUCO_LIFE_REC_SIZE];
+  duco_life_encode(r, rec);
+  File f = LittleFS.open(kLifePath, "r+");
+  const bool ok = f && f.seek(g_lifeSlot * DUCO_LIFE_REC_SIZE) &&
+                  f.write(rec, sizeof(rec)) == sizeof(rec);
+  if (f) f.close();
+  if (!ok) {
+    mc_logf("[LIFE] write failed: %s slot %u", kLifePath, (unsigned)g_lifeSlot);
+    return false;
+  }
+  g_lifeWritten = r;
+  g_lifeSlot    = duco_life_next_slot((int)g_lifeSlot);
+  g_lifeFlushMs = millis();
+  ++g_lifeFlushes;
+  return true;
+}
+
+// 起動時（startMiner）に 1 回。スロットを全部読んで一番新しいものから続け、起動 1 回分を書く
+static void life_load_() {
+  g_lifeFs = LittleFS.begin(true);
+  DucoLifeRecord r;
+  int  picked = -1;
+  bool sized  = false;
+  if (g_lifeFs && LittleFS.exists(kLifePath)) {
+    uint8_t buf[DUCO_LIFE_FILE_SIZE];
+    File f = LittleFS.open(kLifePath, "r");
+    const size_t n = f ? f.read(buf, sizeof(buf)) : 0;
+    sized = f && f.size() == DUCO_LIFE_FILE_SIZE;
+    if (f) f.close();
+    picked = duco_life_pick(buf, n, r);
+  }
+  // 無い / 長さが違う：0 埋めのスロットで作り直す（読めた値は RAM にあるので次に書き戻す）
+  if (g_lifeFs && !sized) {
+    File f = LittleFS.open(kLifePath, "w");
+    const uint8_t zero[DUCO_LIFE_REC_SIZE] = {0};
+    for (size_t i = 0; f && i < DUCO_LIFE_SLOTS; ++i) f.write(zero, sizeof(zero));
+    if (f) f.close();
+    if (!f) g_lifeFs = false;
+    picked = -1;
+  }
+  g_lifeWritten = r;
+  g_lifeSlot    = duco_life_next_slot(picked);
+  r.boots++;
+  life_write_(r);
+  g_lifeBase = r;
+  g_lifeNow  = r;
+  mc_logf("[LIFE] boots=%u acc=%u rej=%u hashes=%llu up=%us (%s)",
+          (unsigned)r.boots, (unsigned)r.accepted, (unsigned)r.rejected,
+          (unsigned long long)r.hashes, (unsigned)r.uptime_s, g_lifeFs ? "fs" : "ram only");
+}
 
+static void life_tick_() {
+  const unsigned long now = millis();
+  if (g_lifeLastMs && now - g_lifeLastMs < 1000) return;
+  const unsigned long prev = g_lifeLastMs;
+  g_lifeLastMs = now;
+
+  // ワーカーが実際に回していた間だけ、前の tick からの実時間を足す
+  // （一時停止 / 全スレッド無効の間は、ジョブを持っていても停めてあるので入れない）
+  bool hashing = false;
+  if (!g_miningPaused && g_mining_active_threads > 0) {
+    for (int k = 0; k < DUCO_IO_MAX_CONNS && !hashing; ++k) {
+      hashing = (duco_io_conn(k).state == CONN_WORKING);
+    }
+  }
+  if (hashing && prev) g_lifeMiningMs += now - prev;
+  DucoLifeRecord r = g_lifeBase;
+  r.seq       = g_lifeWritten.seq;
+  r.accepted += g_acc_all;
+  r.rejected += g_rej_all;
+  r.hashes   += duco_io_hashes();
+  r.uptime_s += (uint32_t)(esp_timer_get_time() / 1000000LL);
+  r.mining_s += (uint32_t)(g_lifeMiningMs / 1000);
+
+  if (g_lifeFlushReq ||
+      duco_life_flush_due(r, g_lifeWritten, (uint32_t)(now - g_lifeFlushMs),
+                          (uint32_t)MC_DUCO_LIFE_FLUSH_S * 1000UL, MC_DUCO_LIFE_FLUSH_SHARES)) {
+    g_lifeFlushReq = false;
+    life_write_(r);
+  }
+  portENTER_CRITICAL(&g_lifeMux);
+  g_lifeNow = r;
+  portEXIT_CRITICAL(&g_lifeMux);
+}
+
+// ---- ★追加: ジョブの記録のリング（@JOBS。書くのは I/O タスク、読むのはシリアルのループ） ----
+static_assert((int)MINING_JOB_GOOD == (int)DUCO_TRACE_FB_GOOD &&
+              (int)MINING_JOB_LOST == (int)DUCO_TRACE_FB_LOST, "job result != trace feedback");
+static MiningJobRecord g_jobRing[MC_DUCO_JOB_RING];
+static uint32_t        g_jobSeq = 0;   // 書いた件数（= 最後の記録の seq）
+static portMUX_TYPE    g_jobMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ---- ★追加: duco_io から呼ばれる側（DucoIoHooks。ワーカーから呼ばれる io_solve_ / io_rate_ 以外は I/O タスク） ----
+// ジョブの記録が閉じた（feedback まで揃った / 切れた / 答えが無かった / 捨てた）
+static void io_record_(const MiningJobRecord& r) {
+  portENTER_CRITICAL(&g_jobMux);
+  MiningJobRecord& slot = g_jobRing[g_jobSeq % MC_DUCO_JOB_RING];
+  slot     = r;
+  slot.seq = ++g_jobSeq;
+  portEXIT_CRITICAL(&g_jobMux);
+}
+
+static void io_trace_(const DucoTraceRecord& r) {
+  if (g_traceMode != MINING_TRACE_OFF) trace_emit_(r);
+}
+
+static void io_status_(const char* text) {
+  g_status = text;
+}
+
+static void io_diag_(const char* text) {
+  g_poolDiagText = text;
+}
+
+static void io_ident_(DucoIoIdent& id) {
   const auto& cfg = appConfig();
+  id.user     = cfg.duco_user;
+  id.key      = cfg.duco_miner_key;
+  id.banner   = cfg.duco_banner;
+  id.version  = cfg.app_version;
+  id.rig      = cfg.duco_rig_name;
+  id.chip     = g_chip_id;
+  id.walletid = (uint32_t)g_walletid;
+}
 
-  for (;;) {
-    // ----- mining control: idle if this thread is disabled (STOP/HALF) -----
-    if (idx >= (int)g_mining_active_threads) {
-      me.connected   = false;
-      me.hashrate_kh = 0.0f;
-      vTaskDelay(pdMS_TO_TICKS(200));
-      continue;
+// 張っておく接続の本数（= 同時に持つジョブの数）
+static int io_wanted_conns_() {
+  if (g_miningPaused) return 0;   // 止めている間は新しい JOB をもらわない（持っているジョブはそのまま）
+  const int consumers = coop_active_() ? 1 : (int)g_mining_active_threads;
+  if (consumers <= 0) return 0;
+  const int n = consumers + MC_DUCO_IO_SPARE_JOBS;
+  return (n > DUCO_IO_MAX_CONNS) ? DUCO_IO_MAX_CONNS : n;
+}
+
+// ---- ★追加: 候補表 ----
+static int pool_sel_add_(const DucoPoolEntry& e, DucoPoolOrigin origin) {
+  portENTER_CRITICAL(&g_poolSelMux);
+  const int i = duco_pool_sel_add(g_poolSel, e.host, e.port, e.name, origin, g_poolCurIdx);
+  portEXIT_CRITICAL(&g_poolSelMux);
+  return i;
+}
+
+static bool pool_sel_entry_(int i, DucoPoolEntry& out) {
+  bool ok = false;
+  portENTER_CRITICAL(&g_poolSelMux);
+  if (i >= 0 && i < g_poolSel.n) {
+    const DucoPoolCand& c = g_poolSel.c[i];
+    memcpy(out.name, c.name, sizeof(out.name));
+    memcpy(out.host, c.host, sizeof(out.host));
+    out.port       = c.port;
+    out.fetched_at = duco_pool_now_s();
+    ok = true;
+  }
+  portEXIT_CRITICAL(&g_poolSelMux);
+  return ok;
+}
+
+// 1 候補の TCP connect と banner が届くまでを測る（DucoPool タスク。最大 6 秒ほど止まる）
+static bool pool_probe_one_(const char* host, uint16_t port, float& connMs, float& bannerMs) {
+  WiFiClient cli;
+  const int64_t t0 = esp_timer_get_time();
+  if (!cli.connect(host, port, 3000)) return false;
+  const int64_t t1 = esp_timer_get_time();
+
+  DucoLineBuf lb;
+  bool got = false;
+  while (!got && esp_timer_get_time() - t1 < 3000000) {
+    while (!got && cli.available()) {
+      const int ch = cli.read();
+      if (ch < 0) break;
+      got = duco_line_push(lb, (char)ch);
     }
+    if (!got) vTaskDelay(pdMS_TO_TICKS(2));
+  }
+  const int64_t t2 = esp_timer_get_time();
+  cli.stop();
+
+  const char* ver = nullptr;
+  if (!got || !duco_parse_banner(lb.buf, &ver)) return false;
+  connMs   = (float)(t1 - t0) / 1000.0f;
+  bannerMs = (float)(t2 - t1) / 1000.0f;
+  return true;
+}
 
-    // WiFi
-    while (WiFi.status() != WL_CONNECTED) {
-      // disabled while waiting for WiFi -> just idle
-      if (idx >= (int)g_mining_active_threads) {
-        me.connected   = false;
-        me.hashrate_kh = 0.0f;
-        vTaskDelay(pdMS_TO_TICKS(200));
-        continue;
-      }
-      me.connected = false;
-      g_status = "WiFi connecting...";
-      g_poolDiagText = "Waiting for WiFi connection.";           // ★追加
-      vTaskDelay(pdMS_TO_TICKS(1000));
+// 設定の pool_nodes を g_poolNodes に写す（ループタスク = startMiner / requestPoolProbe から）
+static void pool_nodes_copy_() {
+  const char* src = mcCfgPoolNodes();
+  size_t      len = strlen(src);
+  if (len >= sizeof(g_poolNodes)) {
+    mc_logf("[POOL] pool_nodes too long (%u bytes), ignored", (unsigned)len);
+    len = 0;
+  }
+  portENTER_CRITICAL(&g_poolSelMux);
+  memcpy(g_poolNodes, src, len);
+  g_poolNodes[len] = '\0';
+  portEXIT_CRITICAL(&g_poolSelMux);
+}
+
+// 候補を全部測る（設定の pool_nodes もここで足すので、SET の後は次の回から候補に入る）
+static void pool_probe_all_() {
+  char        nodes[sizeof(g_poolNodes)];
+  DucoPoolSel user;
+  portENTER_CRITICAL(&g_poolSelMux);
+  memcpy(nodes, g_poolNodes, sizeof(nodes));
+  portEXIT_CRITICAL(&g_poolSelMux);
+  duco_pool_parse_nodes(nodes, &user);
+  portENTER_CRITICAL(&g_poolSelMux);
+  for (int i = 0; i < user.n; ++i) {
+    duco_pool_sel_add(g_poolSel, user.c[i].host, user.c[i].port, nullptr,
+                      DUCO_POOL_FROM_USER, g_poolCurIdx);
+  }
+  const int n = g_poolSel.n;
+  portEXIT_CRITICAL(&g_poolSelMux);
+
+  for (int i = 0; i < n; ++i) {
+    if (WiFi.status() != WL_CONNECTED) return;
+    char     host[sizeof(g_poolSel.c[0].host)];
+    uint16_t port;
+    portENTER_CRITICAL(&g_poolSelMux);
+    memcpy(host, g_poolSel.c[i].host, sizeof(host));
+    port = g_poolSel.c[i].port;
+    portEXIT_CRITICAL(&g_poolSelMux);
+
+    float connMs = 0.0f, bannerMs = 0.0f;
+    const bool ok = pool_probe_one_(host, port, connMs, bannerMs);
+
+    float score;
+    portENTER_CRITICAL(&g_poolSelMux);
+    // 測っている間に入れ替わっていなければ
+    if (duco_pool_sel_find(g_poolSel, host, port) == i) {
+      duco_pool_sel_probe(g_poolSel, i, ok, connMs, bannerMs);
+    }
+    score = duco_pool_sel_score(g_poolSel.c[i]);
+    portEXIT_CRITICAL(&g_poolSelMux);
+
+    if (ok) {
+      mc_logf("[POOL] probe %s:%u connect=%.1f ms banner=%.1f ms score=%.1f",
+              host, (unsigned)port, connMs, bannerMs, score);
+    } else {
+      mc_logf("[POOL] probe %s:%u failed", host, (unsigned)port);
     }
+  }
 
-    // Pool
-    if (g_port == 0) {
-      if (!duco_get_pool()) {
-        // duco_get_pool() 内で g_poolDiagText を設定済み
-        vTaskDelay(pdMS_TO_TICKS(5000));
-        continue;
+  g_poolProbeSeq = g_poolProbeSeq + 1;
+  if (g_ioTask) xTaskNotifyGive(g_ioTask);
+}
+
+// getPool を取りに行き（起動直後と、I/O タスクに頼まれたとき）、候補を MC_DUCO_POOL_PROBE_MS ごとに測る
+static void duco_pool_task(void* pv) {
+  bool     fetched     = false;   // この起動で getPool が取れた
+  uint32_t backoffMs   = 5000;
+  uint32_t nextFetchMs = millis();
+  uint32_t nextProbeMs = millis();
+
+  for (;;) {
+    while (WiFi.status() != WL_CONNECTED) vTaskDelay(pdMS_TO_TICKS(1000));
+
+    if ((!fetched && (int32_t)(millis() - nextFetchMs) >= 0) || g_poolWantFetch) {
+      g_poolWantFetch = false;
+      DucoPoolEntry e;
+      const char*   diag = nullptr;
+      const unsigned long t0 = millis();
+      if (duco_fetch_pool_(e, diag)) {
+        mc_logf("[DUCO] getPool done in %lu ms", (unsigned long)(millis() - t0));
+        pool_sel_add_(e, DUCO_POOL_FROM_GETPOOL);
+        while (g_poolFreshReady) vTaskDelay(pdMS_TO_TICKS(100));
+        g_poolFresh     = e;
+        g_poolFetchDiag = nullptr;
+        __atomic_store_n(&g_poolFreshReady, true, __ATOMIC_RELEASE);
+        if (g_ioTask) xTaskNotifyGive(g_ioTask);
+        fetched     = true;
+        backoffMs   = 5000;
+        nextProbeMs = millis();   // 新しい候補をすぐ測る
+      } else {
+        g_poolFetchDiag = diag;
+        fetched     = false;
+        // キャッシュで掘れている間は急がない（5 秒から倍々で最大 5 分）
+        nextFetchMs = millis() + backoffMs;
+        if (backoffMs < 5UL * 60UL * 1000UL) backoffMs *= 2;
       }
     }
 
-    WiFiClient cli;
-    cli.setTimeout(15);
-    Serial.printf("[DUCO-%s] connect %s:%u ...\n",
-                  tag, g_host.c_str(), g_port);
-    if (!cli.connect(g_host.c_str(), g_port)) {
-      me.connected = false;
-      g_poolDiagText = "Cannot connect to the pool node.";   // ★追加
-      vTaskDelay(pdMS_TO_TICKS(1000));
-      continue;
+    if (g_poolProbeNow || (int32_t)(millis() - nextProbeMs) >= 0) {
+      g_poolProbeNow = false;
+      pool_probe_all_();
+      nextProbeMs = millis() + MC_DUCO_POOL_PROBE_MS;
     }
 
-    // banner
-    unsigned long t0 = millis();
-    while (!cli.available() && cli.connected() && millis() - t0 < 5000) {
-      vTaskDelay(pdMS_TO_TICKS(10));
+    // 次に測る / getPool をやり直すまで（頼まれたら xTaskNotifyGive ですぐ起きる）
+    int32_t waitMs = (int32_t)(nextProbeMs - millis());
+    if (!fetched) {
+      const int32_t f = (int32_t)(nextFetchMs - millis());
+      if (f < waitMs) waitMs = f;
     }
-    if (!cli.available()) {
-      cli.stop();
-      g_poolDiagText = "Pool node is not responding.";     // ★追加
-      vTaskDelay(pdMS_TO_TICKS(2000));
-      continue;
+    if (waitMs < 10) waitMs = 10;
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs));
+  }
+}
+
+// ---- ★追加: プールノードの切り替え（I/O タスク） ----
+static void pool_apply_(const DucoPoolEntry& e, DucoPoolSource src) {
+  const bool moved = !duco_pool_entry_same_node(g_poolCur, e);
+  g_poolCur        = e;
+  g_poolSrc        = src;
+  g_node_name      = e.name;
+  duco_io_set_pool(e.host, e.port, e.name);
+  g_poolFailStreak = 0;
+  g_poolFailed     = false;
+  g_poolUnsaved    = (src == POOL_SRC_FETCH || src == POOL_SRC_PROBE);
+  const int idx = pool_sel_add_(e, src == POOL_SRC_CACHE ? DUCO_POOL_FROM_CACHE
+                                                         : DUCO_POOL_FROM_GETPOOL);
+  portENTER_CRITICAL(&g_poolSelMux);
+  g_poolCurIdx = idx;
+  portEXIT_CRITICAL(&g_poolSelMux);
+  if (moved) {
+    // 別のノードへ：今の接続は捨てて繋ぎ直す。
+    // ★変更: 測り直しでの乗り換え（今のノードは生きている）は、解きかけのジョブと
+    //         submit 済みのシェアの feedback を待ってから閉じる（もう JOB は送らない）。
+    //         失敗 / キャッシュ切れ / getPool での乗り換えは今すぐ
+    const int draining = duco_io_reconnect(src == POOL_SRC_PROBE);
+    if (draining) mc_logf("[DUCO] draining %d connection(s) to the old pool", draining);
+  }
+  mc_logf("[DUCO] use pool %s (%s:%u) from %s", e.name, e.host, (unsigned)e.port,
+          src == POOL_SRC_CACHE ? "cache" : src == POOL_SRC_PROBE ? "probe" : "getPool");
+}
+
+// DucoPool タスクの結果を取り込む
+static void pool_take_fresh_() {
+  if (!__atomic_load_n(&g_poolFreshReady, __ATOMIC_ACQUIRE)) return;
+  const DucoPoolEntry e = g_poolFresh;
+  __atomic_store_n(&g_poolFreshReady, false, __ATOMIC_RELEASE);
+
+  if (g_poolSrc == POOL_SRC_NONE || g_poolFailed ||
+      duco_pool_entry_same_node(g_poolCur, e)) {
+    pool_apply_(e, POOL_SRC_FETCH);
+    return;
+  }
+  if (g_poolSrc == POOL_SRC_CACHE &&
+      duco_pool_cache_expired(g_poolCur, MC_DUCO_POOL_CACHE_MAX_AGE_S)) {
+    mc_logf("[DUCO] cached pool expired -> switch");
+    pool_apply_(e, POOL_SRC_FETCH);
+    return;
+  }
+  // キャッシュのノードはまだ新しく繋がっている -> そのまま（getPool のノードは候補表に入っている）
+  mc_logf("[DUCO] keep cached pool %s, %s is a candidate", g_poolCur.name, e.name);
+}
+
+// ★追加: 測り終えたら、一番良い候補が今のノードより十分に良いか見る
+static void pool_consider_switch_() {
+  static uint32_t seen = 0;
+  const uint32_t seq = g_poolProbeSeq;
+  if (seq == seen) return;
+  seen = seq;
+
+  portENTER_CRITICAL(&g_poolSelMux);
+  const int   cur  = g_poolCurIdx;
+  const int   pick = duco_pool_sel_pick(g_poolSel, cur, MC_DUCO_POOL_SWITCH_MARGIN,
+                                        MC_DUCO_POOL_SWITCH_GAP_MS);
+  const float sc   = (cur >= 0) ? duco_pool_sel_score(g_poolSel.c[cur]) : DUCO_POOL_SCORE_NONE;
+  const float sp   = (pick >= 0) ? duco_pool_sel_score(g_poolSel.c[pick]) : DUCO_POOL_SCORE_NONE;
+  portEXIT_CRITICAL(&g_poolSelMux);
+
+  DucoPoolEntry e;
+  if (pick < 0 || !pool_sel_entry_(pick, e)) return;
+  mc_logf("[DUCO] better pool %s (score %.1f < %.1f)", e.name, sp, sc);
+  pool_apply_(e, POOL_SRC_PROBE);
+}
+
+// ★追加: 今のノードで受けた feedback（候補のスコアの reject 率に入る。前のノードの分は入れない）
+static void pool_note_share_(const DucoConn& c, bool accepted) {
+  if (c.drain) return;
+  portENTER_CRITICAL(&g_poolSelMux);
+  duco_pool_sel_share(g_poolSel, g_poolCurIdx, accepted);
+  portEXIT_CRITICAL(&g_poolSelMux);
+}
+
+// 今のノードへの接続 / banner が失敗した
+static void pool_note_fail_() {
+  if (++g_poolFailStreak < MC_DUCO_POOL_FAIL_MAX) return;
+  if (g_poolFailed) return;   // もう getPool を頼んである
+  mc_logf("[DUCO] pool %s failed %u times", g_poolCur.name, (unsigned)g_poolFailStreak);
+
+  // ★変更: 測れている別の候補があればそこへ。無ければ getPool を取り直す
+  portENTER_CRITICAL(&g_poolSelMux);
+  duco_pool_sel_probe(g_poolSel, g_poolCurIdx, false, 0.0f, 0.0f);
+  const int alt = duco_pool_sel_best(g_poolSel, g_poolCurIdx);
+  portEXIT_CRITICAL(&g_poolSelMux);
+  DucoPoolEntry e;
+  if (alt >= 0 && pool_sel_entry_(alt, e)) {
+    pool_apply_(e, POOL_SRC_PROBE);
+    return;
+  }
+  g_poolFailed    = true;
+  g_poolWantFetch = true;
+  if (g_poolTask) xTaskNotifyGive(g_poolTask);
+}
+
+// 今のノードに繋がった（getPool で取ったノードなら「最後に繋がったノード」として覚える）
+static void pool_note_ok_() {
+  g_poolFailStreak = 0;
+  if (g_poolUnsaved) {
+    g_poolUnsaved = false;
+    if (duco_pool_cache_save(g_poolCur)) {
+      mc_logf("[DUCO] pool cached: %s (%s:%u)", g_poolCur.name, g_poolCur.host,
+              (unsigned)g_poolCur.port);
     }
-    String serverVer = cli.readStringUntil('\n');
-    g_status       = String("connected (") + tag + ") " + g_node_name;
-    serverVer.trim();  // ← ここ追加
-    g_poolDiagText = "";                          // ★ここで一旦「エラーなし」に
-
-    // ★ 追加：サーバーバージョンをログ
-    mc_logf("[DUCO-%s] server version: %s",
-        tag, serverVer.c_str());
-    me.connected = true;
-    g_status = String("connected (") + tag + ") " + g_node_name;
-
-    // ===== JOB loop =====
-    while (cli.connected()) {
-      // disabled mid-connection -> disconnect and go idle
-      if (idx >= (int)g_mining_active_threads) {
-        mc_logf("[DUCO-%s] disabled -> disconnect", tag);
-        cli.stop();
-        me.connected   = false;
-        me.hashrate_kh = 0.0f;
-        vTaskDelay(pdMS_TO_TICKS(200));
-        break;
-      }
+  }
+}
 
-      // Request job（user, board, miningKey）
-      // Request job（user, board, miningKey）
-      // NOTE:
-      //   ESP32 を名乗ると Kolka に「Too high starting difficulty」と言われて全シェアがリジェクトされる。
-      //   AVR を名乗れば通るが、実際は ESP32 なのでボード名で嘘をつきたくない。
-      //   そのため、汎用スタート難易度ラベル "LOW" を指定し、具体的な難易度調整は
-      //   サーバー側（Kolka）に任せる方針。
-      String req = String("JOB,") + cfg.duco_user + ",LOW," +
-                  cfg.duco_miner_key + "\n";
+// feedback を受けた（切断 / タイムアウトは不受理）
+static void io_share_(const DucoConn& c, bool accepted) {
+  if (accepted) ++g_acc_all;
+  else          ++g_rej_all;
+  pool_note_share_(c, accepted);
+}
 
-      // ★ 追加：何を投げたか（miner_key はログに出さない）
-      mc_logf("[DUCO-%s] send JOB user=%s board=LOW",
-              tag, cfg.duco_user);
+// ★追加: 起動から最初のジョブまで（キャッシュのノードが効いているかの目安）
+static void io_job_queued_(const DucoConn& c, float turn_ms) {
+  (void)c;
+  (void)turn_ms;
+  if (g_firstJobMs) return;
+  g_firstJobMs = millis() ? millis() : 1;
+  mc_logf("[DUCO] first job after %lu ms (pool from %s)", (unsigned long)g_firstJobMs,
+          g_poolSrc == POOL_SRC_CACHE ? "cache" : "getPool");
+}
 
+static void duco_io_task(void* pv) {
+  mc_logf("[DUCO-IO] pool I/O task start");
+  duco_io_set_task(xTaskGetCurrentTaskHandle());
 
-      unsigned long ping0 = millis();
-      cli.print(req);
+  for (;;) {
+    trace_apply_mode_();   // ★追加: TRACE ON / OFF
+    hr_series_tick_();     // ★追加: ハッシュレートの時系列
+    life_tick_();          // ★追加: 通算カウンタ（しきい値を超えたら LittleFS へ）
 
-      // job を待つ
-      t0 = millis();
-      while (!cli.available() && cli.connected() && millis() - t0 < 10000) {
-        vTaskDelay(pdMS_TO_TICKS(10));
-      }
-      if (!cli.available()) {
-        me.connected = false;
-        g_status = String("no job (") + tag + ")";
+    // ワーカーの結果を先に（submit は早いほどいい）
+    duco_io_results(io_wanted_conns_());
 
-        // ★ 追加：タイムアウトをログ
-        mc_logf("[DUCO-%s] no job (timeout)", tag);
-        g_poolDiagText = "No job response from the pool."; // ★追加
-        break;
-      }
-      me.last_ping_ms = (float)(millis() - ping0);
-
-      // ★ 追加：ping をログ
-      mc_logf("[DUCO-%s] job ping = %.1f ms",
-          tag, me.last_ping_ms);
-
-      // job: previousHash,expectedHash,difficulty\n
-      String prev     = cli.readStringUntil(',');
-      String expected = cli.readStringUntil(',');
-      String diffStr  = cli.readStringUntil('\n');
-      prev.trim();
-      expected.trim();
-      diffStr.trim();
-
-      int difficulty = diffStr.toInt();
-      if (difficulty <= 0) difficulty = 1;
-      me.difficulty = (uint32_t)difficulty;
-
-      // ★追加：演出用スナップショットの“お題”を保存（prev + difficulty）
-      portENTER_CRITICAL(&g_statsMux);
-      me.work_diff = (uint32_t)difficulty;
-      me.work_valid = false;  // 新ジョブ開始で一旦リセット
-      strncpy(me.work_seed, prev.c_str(), 40);
-      me.work_seed[40] = '\0';
-      portEXIT_CRITICAL(&g_statsMux);
-
-
-     // ★ 追加：ジョブの中身をログ
-     mc_logf("[DUCO-%s] job diff=%d prev=%s expected=%s",
-          tag, difficulty,
-          prev.c_str(), expected.c_str());
-
-      // expected(hex) → 20バイト
-      const size_t SHA_LEN = 20;
-      unsigned char expBytes[SHA_LEN];
-      memset(expBytes, 0, sizeof(expBytes));
-      size_t elen = expected.length() / 2;
-      const char* ce = expected.c_str();
-      auto h = [](char c) -> uint8_t {
-        c = toupper((uint8_t)c);
-        if (c >= '0' && c <= '9') return (uint8_t)(c - '0');
-        if (c >= 'A' && c <= 'F') return (uint8_t)(c - 'A' + 10);
-        return 0;
-      };
-      for (size_t i = 0, j = 0; j < elen && j < SHA_LEN; i += 2, ++j) {
-        expBytes[j] = (h(ce[i]) << 4) | h(ce[i + 1]);
-      }
+    // WiFi
+    if (WiFi.status() != WL_CONNECTED) {
+      duco_io_close_all();
+      g_status = "WiFi connecting...";
+      g_poolDiagText = "Waiting for WiFi connection.";           // ★追加
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+      continue;
+    }
 
-      // solve
-      uint32_t hashes = 0;
-      unsigned long tStart = micros();
-      uint32_t foundNonce =
-          duco_solve_duco_s1(prev, expBytes, (uint32_t)difficulty, hashes, &me);
-
-      if (foundNonce == DUCO_ABORTED) {
-        // mining control requested to stop this thread
-        mc_logf("[DUCO-%s] job aborted by control", tag);
-        cli.stop();
-        me.connected   = false;
-        me.hashrate_kh = 0.0f;
-        vTaskDelay(pdMS_TO_TICKS(200));
-        break;
+    // Pool（★変更: キャッシュのノードがあればそれで先に繋ぎ、getPool の結果は裏で届く）
+    pool_take_fresh_();
+    pool_consider_switch_();
+    if (g_poolCur.port == 0) {
+      const char* diag = g_poolFetchDiag;
+      g_poolDiagText = diag ? diag : "Fetching pool info...";
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+      continue;
+    }
+    // getPool が今と同じノードを返した（繋ぎ直さない）-> 繋がっていればここでキャッシュを更新
+    if (g_poolUnsaved) {
+      for (int k = 0; k < DUCO_IO_MAX_CONNS; ++k) {
+        const DucoConn& c = duco_io_conn(k);
+        if (c.connected && !c.drain) { pool_note_ok_(); break; }
       }
+    }
 
-      float sec = (micros() - tStart) / 1000000.0f;
-      if (sec <= 0) sec = 0.001f;
-      float hps = hashes / (sec > 0 ? sec : 0.001f);
-
-      
-      // ★ 追加：solver の実績をログ
-      mc_logf("[DUCO-%s] solved nonce=%u hashes=%u time=%.3fs (%.1f H/s)",
-            tag,
-            (unsigned)foundNonce,
-            (unsigned)hashes,
-            sec,
-            hps);
-
-      if (foundNonce == UINT32_MAX) {
-        g_status = String("no share (") + tag + ")";
-        vTaskDelay(pdMS_TO_TICKS(5));
-        continue;
-      }
+    duco_io_step_all(io_wanted_conns_());
 
-      me.hashrate_kh = hps / 1000.0f;
-      me.shares++;
-
-      // Submit: nonce,hashrate,banner ver,rig,DUCOID<chip>,<walletid>\n
-      String submit =
-          String(foundNonce) + "," + String(hps) + "," +
-          String(cfg.duco_banner) + " " + cfg.app_version + "," +
-          cfg.duco_rig_name + "," +
-          "DUCOID" + String((char*)g_chip_id) + "," +
-          String(g_walletid) + "\n";
-      cli.print(submit);
-
-      
-      // ★ 追加：送った内容（短く）をログ
-      mc_logf("[DUCO-%s] submit nonce=%u hps=%.1f",
-              tag, (unsigned)foundNonce, hps);
-
-      // feedback
-      t0 = millis();
-      while (!cli.available() && cli.connected() && millis() - t0 < 10000) {
-        vTaskDelay(pdMS_TO_TICKS(10));
-      }
-      if (!cli.available()) {
-        g_status = String("no feedback (") + tag + ")";
+    // 結果が来たら（xTaskNotifyGive）すぐ、来なくても MC_DUCO_IO_POLL_MS でソケットを見に行く
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(MC_DUCO_IO_POLL_MS));
+  }
+}
 
-        // ★ 追加：timeout も「失敗したシェア」として数える
-        ++me.rejected;
-        ++g_rej_all;
+// ---------------- Miner Task 本体（計算だけ） ----------------
+// ジョブの受け取り / 停めたジョブの戻し / 結果の返し方は duco_io_run_job。解くのはここ
+static uint32_t io_solve_(int idx, const DucoJobMsg& job, const uint32_t* connGen,
+                          DucoIoSolve& out) {
+  DucoThreadStats& me = g_thr[idx];
+  me.difficulty = job.difficulty;
+  // ★追加：演出用スナップショットの“お題”を保存（prev + difficulty）
+  work_set_job_(me, job.prev, job.difficulty);  // 新ジョブ開始で一旦リセット
+
+  const unsigned long tStart = micros();
+  const uint32_t found =
+      duco_solve_duco_s1(job.prev, job.prevLen, job.expected, job.difficulty, job.next,
+                         out.hashes, &me, connGen, job.connGen,
+                         &out.own, &out.next, &out.stall_us);
+  me.last_solve_ms = (uint32_t)(micros() - tStart) / 1000.0f;
+  return found;
+}
 
-        mc_logf("[DUCO-%s] no feedback (timeout)", tag);
-        g_poolDiagText = "No result response from the pool."; // ★追加
-        break;
-      }
-      String fb = cli.readStringUntil('\n');
-      fb.trim();
-
-      // ★ 追加：フィードバックそのもの
-      mc_logf("[DUCO-%s] feedback: '%s'", tag, fb.c_str());
-
-      if (fb.startsWith("GOOD")) {
-        ++me.accepted;
-        ++g_acc_all;
-        g_status = String("share GOOD (#") + String(me.shares) +
-                   ", " + tag + ")";
-        g_poolDiagText = "";     // ★正常
-      } else {
-        ++me.rejected;
-        ++g_rej_all;
-        g_status = String("share BAD (#") + String(me.shares) +
-                   ", " + tag + ")";
-        // BAD のときはとりあえず直ちにPoolエラー扱いにはしない
-      }
+static void io_rate_(int idx, float wall_kh, float compute_kh) {
+  g_thr[idx].hashrate_kh = wall_kh;
+  g_thr[idx].compute_kh  = compute_kh;
+}
 
-      vTaskDelay(pdMS_TO_TICKS(5));
+static void duco_task(void* pv) {
+  int idx = (int)(intptr_t)pv;
+  if (idx < 0 || idx >= (int)g_miner_threads) idx = 0;
+  auto& me = g_thr[idx];
+
+  char tag[8];
+  snprintf(tag, sizeof(tag), "T%d", idx);
+  mc_logf("[DUCO-%s] miner task start", tag);
+
+  for (;;) {
+    // ----- mining control: idle if this thread is disabled (STOP/HALF) -----
+    if (idx >= (int)g_mining_active_threads) {
+      me.hashrate_kh = 0.0f;
+      me.compute_kh  = 0.0f;
+      waitEnabled_(idx, 1000);   // ★変更: 有効になった瞬間に起きる
+      continue;
     }
 
-    cli.stop();
-    me.connected = false;
-    vTaskDelay(pdMS_TO_TICKS(2000));
+    // ★協調モード: ジョブを取るのはスレッド0だけ。他はそのジョブの nonce 範囲を分担する
+    if (coop_active_() && idx != 0) {
+      coop_help_(idx, me);
+      continue;
+    }
+
+    waitWhilePaused_();
+
+    // ジョブ待ち（disable / 協調モードへの切り替えに気付けるよう短めに区切る）
+    DucoJobMsg job;
+    if (!duco_io_job_take(job, 100)) continue;
+
+    // 待っている間に止められた -> 他のワーカーに回す
+    if (idx >= (int)g_mining_active_threads || (coop_active_() && idx != 0)) {
+      duco_io_job_return(job);
+      continue;
+    }
+
+    duco_io_run_job(idx, job);
+  }
+}
+
+// ★追加: miner_cores（"0,1" / "1,1,1" / "a" ...）の i 番目。足りなければ先頭から繰り返す
+static BaseType_t miner_core_for_(const char* cores, int i) {
+  int n = 0;
+  for (const char* p = cores; p && *p; ++p) {
+    if (*p == '0' || *p == '1' || *p == 'a') ++n;
+  }
+  if (n == 0) return (i == 0) ? 0 : 1;   // 従来の割り当て
+  int k = i % n;
+  for (const char* p = cores; *p; ++p) {
+    if (!(*p == '0' || *p == '1' || *p == 'a')) continue;
+    if (k-- == 0) return (*p == 'a') ? (BaseType_t)tskNO_AFFINITY : (BaseType_t)(*p - '0');
   }
+  return tskNO_AFFINITY;
 }
 
 // ---------------- 公開関数 ----------------
@@ -523,6 +1570,7 @@ void startMiner() {
   }
 
   g_shaMutex = xSemaphoreCreateMutex();
+  ctl_events_();   // ★追加: pause / enable 通知（ワーカーより先に作る）
 
   uint64_t chipid = ESP.getEfuseMac();
   uint16_t chip   = (uint16_t)(chipid >> 32);
@@ -534,17 +1582,74 @@ void startMiner() {
 
   WiFi.setSleep(false);
 
-  for (int i = 0; i < DUCO_MINER_THREADS; ++i) {
+  // ★追加: ワーカーを起こす前にカーネルを測って選び、既知解で確かめる（CPU を占有するのはここだけ）
+  select_kernel_();
+  selftest_kernel_();
+  if (g_kernelDiag.length()) g_poolDiagText = g_kernelDiag;
+
+  // ★変更: ワーカー数 / コア / 優先度は mc_config_store から（既定は 2 本・コア 0,1・優先度 1）
+  uint8_t n = mcCfgMinerThreads();
+  if (n < 1) n = 1;
+  if (n > DUCO_MINER_MAX_THREADS) n = DUCO_MINER_MAX_THREADS;
+  g_miner_threads = n;
+  if (g_mining_active_threads > n) g_mining_active_threads = n;
+  ctl_sync_bits_();
+
+  for (int i = 0; i < DUCO_MINER_MAX_THREADS; ++i) {
     g_thr[i] = DucoThreadStats();
   }
   g_acc_all = g_rej_all = 0;
+  life_load_();   // ★追加: 通算カウンタは前回の続きから
+
+  pool_nodes_copy_();   // DucoPool タスクより先に
 
-  for (int i = 0; i < DUCO_MINER_THREADS; ++i) {
-    int core = (i == 0) ? 0 : 1;
-    UBaseType_t prio = 1;
-    String name = String("DucoMiner") + String(i);
+  // ★追加: 前回繋がったノードがあれば getPool を待たずにそれで始める
+  DucoPoolEntry cached;
+  if (duco_pool_cache_load(cached)) {
+    pool_apply_(cached, POOL_SRC_CACHE);
+  }
+
+  // ★追加: プール I/O タスク（全接続）と、ワーカーに配るジョブキュー
+  DucoIoHooks hooks;
+  hooks.status     = io_status_;
+  hooks.diag       = io_diag_;
+  hooks.ident      = io_ident_;
+  hooks.pool_ok    = pool_note_ok_;
+  hooks.pool_fail  = pool_note_fail_;
+  hooks.share      = io_share_;
+  hooks.job_queued = io_job_queued_;
+  hooks.record     = io_record_;
+  hooks.trace      = io_trace_;
+  hooks.solve      = io_solve_;
+  hooks.rate       = io_rate_;
+  duco_io_set_hps_compute(g_hrPolicy == MINING_HR_COMPUTE);
+  duco_io_begin(hooks, n);
+  xTaskCreatePinnedToCore(duco_io_task,
+                          "DucoIO",
+                          8192,
+                          nullptr,
+                          MC_DUCO_IO_PRIO,
+                          &g_ioTask,
+                          MC_DUCO_IO_CORE);
+  // getPool は裏で（キャッシュが無ければ I/O タスクはこれを待つ）
+  xTaskCreatePinnedToCore(duco_pool_task,
+                          "DucoPool",
+                          8192,
+                          nullptr,
+                          1,
+                          &g_poolTask,
+                          MC_DUCO_IO_CORE);
+
+  const UBaseType_t prio  = (UBaseType_t)mcCfgMinerPrio();
+  const char*       cores = mcCfgMinerCores();
+  for (int i = 0; i < (int)n; ++i) {
+    BaseType_t core = miner_core_for_(cores, i);
+    char name[16];
+    snprintf(name, sizeof(name), "DucoMiner%d", i);
+    mc_logf("[DUCO] worker %d: core=%s prio=%u", i,
+            core == tskNO_AFFINITY ? "any" : (core ? "1" : "0"), (unsigned)prio);
     xTaskCreatePinnedToCore(duco_task,
-                            name.c_str(),
+                            name,
                             8192,
                             (void*)(intptr_t)i,
                             prio,
@@ -553,35 +1658,84 @@ void startMiner() {
   }
 }
 
+// ★追加: 分布を p50 / p95 / p99 / max に
+static void latency_fill_(MiningLatency& out, const DucoLatHist& h) {
+  out.n   = h.count;
+  out.p50 = duco_lat_quantile(h, 0.50f);
+  out.p95 = duco_lat_quantile(h, 0.95f);
+  out.p99 = duco_lat_quantile(h, 0.99f);
+  out.max = h.count ? (float)h.max_ms : -1.0f;
+}
+
 // 集計だけ行い、UI に依存しない形で返す
 void updateMiningSummary(MiningSummary& out) {
   const auto features = getRuntimeFeatures();
 
   float    total_kh = 0.0f;
+  float    total_compute_kh = 0.0f;
   float    maxPing  = 0.0f;
   uint32_t acc = 0, rej = 0, diff = 0;
   g_any_connected = false;
 
-  for (int i = 0; i < DUCO_MINER_THREADS; ++i) {
+  float maxSolve = 0.0f, maxFb = 0.0f, maxTurn = 0.0f;
+  DucoLatHist latJob, latFb, latConn;   // ★追加: 接続ごとの分布をまとめる
+  for (int i = 0; i < (int)g_miner_threads; ++i) {
     total_kh += g_thr[i].hashrate_kh;
-    acc      += g_thr[i].accepted;
-    rej      += g_thr[i].rejected;
+    total_compute_kh += g_thr[i].compute_kh;
+    if (g_thr[i].last_solve_ms > maxSolve) maxSolve = g_thr[i].last_solve_ms;
+  }
+
+  // ★変更: シェア・接続の統計はプール接続ごと（I/O タスク）から
+  for (int k = 0; k < DUCO_IO_MAX_CONNS; ++k) {
+    const DucoConn& c = duco_io_conn(k);
+    acc += c.accepted;
+    rej += c.rejected;
 
-    if (g_thr[i].difficulty > diff) diff = g_thr[i].difficulty;
-    if (g_thr[i].connected) g_any_connected = true;
+    if (c.difficulty > diff) diff = c.difficulty;
+    if (c.connected) g_any_connected = true;
 
-    if (g_thr[i].last_ping_ms > maxPing) {
-      maxPing = g_thr[i].last_ping_ms;
+    if (c.last_ping_ms > maxPing) {
+      maxPing = c.last_ping_ms;
     }
+    if (c.last_fb_ms > maxFb)     maxFb   = c.last_fb_ms;
+    if (c.last_turn_ms > maxTurn) maxTurn = c.last_turn_ms;
+    duco_lat_merge(latJob, c.latJob);
+    duco_lat_merge(latFb, c.latFb);
+    duco_lat_merge(latConn, c.latConn);
   }
-
-  out.total_kh      = total_kh;
+  latency_fill_(out.latJob, latJob);
+  latency_fill_(out.latFeedback, latFb);
+  latency_fill_(out.latConnect, latConn);
+  getMiningLifetime(out.lifetime);
+
+  out.total_kh      = (g_hrPolicy == MINING_HR_COMPUTE) ? total_compute_kh : total_kh;
+  out.total_kh_wall    = total_kh;
+  out.total_kh_compute = total_compute_kh;
+  out.hashratePolicy   = g_hrPolicy;
+  portENTER_CRITICAL(&g_hrMux);
+  out.total_kh_ewma    = g_hrSeries.ewma_kh;
+  portEXIT_CRITICAL(&g_hrMux);
   out.accepted      = acc;
   out.rejected      = rej;
   out.maxDifficulty = diff;
   out.anyConnected  = g_any_connected;
   out.poolName      = g_node_name;
+  out.poolCached    = (g_poolSrc == POOL_SRC_CACHE);
+  out.firstJobMs    = g_firstJobMs;
+  portENTER_CRITICAL(&g_poolSelMux);
+  {
+    const int cur = g_poolCurIdx;
+    const int alt = duco_pool_sel_best(g_poolSel, cur);
+    out.poolScore      = (cur >= 0) ? duco_pool_sel_score(g_poolSel.c[cur]) : DUCO_POOL_SCORE_NONE;
+    out.poolBestScore  = (alt >= 0) ? duco_pool_sel_score(g_poolSel.c[alt]) : DUCO_POOL_SCORE_NONE;
+    out.poolCandidates = (uint8_t)g_poolSel.n;
+  }
+  portEXIT_CRITICAL(&g_poolSelMux);
   out.maxPingMs     = maxPing;
+  out.maxFeedbackMs = maxFb;
+  out.maxSolveMs    = maxSolve;
+  out.maxTurnMs     = maxTurn;
+  out.pipelined     = duco_io_pipelined();
   out.miningEnabled = features.miningEnabled;
 
   char logbuf[64];
@@ -590,39 +1744,38 @@ void updateMiningSummary(MiningSummary& out) {
            g_status.startsWith("share GOOD") ? "good " :
            g_status.startsWith("share BAD")  ? "rej  " :
            g_any_connected ? "alive" : "dead ",
-           (unsigned)acc, (unsigned)rej, total_kh, (unsigned)diff);
+           (unsigned)acc, (unsigned)rej, out.total_kh, (unsigned)diff);
   out.logLine40 = String(logbuf);
 
   // ★追加: プール診断メッセージ
-  out.poolDiag = g_poolDiagText;
+  out.poolDiag = g_poolDiagText.length() ? g_poolDiagText : g_kernelDiag;
+
+  // ★追加: 再開レイテンシ（resume / enable の合図 → ワーカーが起きるまで）
+  out.resumeLatencyUs    = g_resumeLastUs;
+  out.resumeLatencyMaxUs = g_resumeMaxUs;
+  out.resumeCount        = g_resumeCount;
+
   // ===== 演出用：SHA1(out) スナップショットを summary に詰める =====
   auto hexDigit = [](uint8_t v) -> char {
     return (v < 10) ? (char)('0' + v) : (char)('a' + (v - 10));
   };
 
-  int wi_connected = -1;
-  int wi_any = -1;
-  for (int i = 0; i < DUCO_MINER_THREADS; ++i) {
-    if (g_thr[i].work_valid) {
-      if (wi_any < 0) wi_any = i;
-      if (g_thr[i].connected && wi_connected < 0) wi_connected = i;
-    }
+  // ★変更: 各スレッドの work を seqlock で読み、一番新しい要求に応えたものを使う
+  DucoWorkData snaps[DUCO_MINER_MAX_THREADS];
+  int wi = -1;
+  for (int i = 0; i < (int)g_miner_threads; ++i) {
+    if (!work_read_(g_thr[i].work, snaps[i])) snaps[i].valid = false;
+    if (!snaps[i].valid) continue;
+    if (wi < 0 || (int32_t)(snaps[i].stamp - snaps[wi].stamp) > 0) wi = i;
   }
-  int wi = (wi_connected >= 0) ? wi_connected : wi_any;
 
   if (wi >= 0) {
-    uint8_t out20[20];
+    const DucoWorkData& w = snaps[wi];
+    const uint8_t* out20 = w.out;
+    const uint32_t nonce = w.nonce, maxNonce = w.max_nonce, diffv = w.diff;
     char seed40[41];
-    uint32_t nonce = 0, maxNonce = 0, diffv = 0;
-
-    portENTER_CRITICAL(&g_statsMux);
-    nonce   = g_thr[wi].work_nonce;
-    maxNonce= g_thr[wi].work_max_nonce;
-    diffv   = g_thr[wi].work_diff;
-    memcpy(out20, g_thr[wi].work_out, 20);
-    strncpy(seed40, g_thr[wi].work_seed, 40);
+    strncpy(seed40, w.seed, 40);
     seed40[40] = '\0';
-    portEXIT_CRITICAL(&g_statsMux);
 
     out.workThread     = (uint8_t)wi;
     out.workNonce      = nonce;
@@ -650,14 +1803,141 @@ void updateMiningSummary(MiningSummary& out) {
 
 // ===== Mining control API (public) =====
 void setMiningActiveThreads(uint8_t activeThreads) {
-  if (activeThreads > DUCO_MINER_THREADS) activeThreads = DUCO_MINER_THREADS;
+  if (activeThreads > g_miner_threads) activeThreads = g_miner_threads;
+  if (activeThreads > g_mining_active_threads) g_resumeSignalUs = esp_timer_get_time();
   g_mining_active_threads = activeThreads;
+  ctl_sync_bits_();
 }
 
 uint8_t getMiningActiveThreads() {
   return g_mining_active_threads;
 }
 
+uint8_t getMiningWorkerCount() {
+  return g_miner_threads;
+}
+
+void requestMiningWorkSample() {
+  __atomic_add_fetch(&g_workReq, 1, __ATOMIC_RELEASE);
+}
+
+void setMiningPipelined(bool on) {
+  duco_io_set_pipelined(on);
+}
+
+bool isMiningPipelined() {
+  return duco_io_pipelined();
+}
+
+int getPoolCandidates(DucoPoolCand* out, int max, int* cur) {
+  portENTER_CRITICAL(&g_poolSelMux);
+  const int n = (g_poolSel.n < max) ? g_poolSel.n : max;
+  for (int i = 0; i < n; ++i) out[i] = g_poolSel.c[i];
+  if (cur) *cur = g_poolCurIdx;
+  portEXIT_CRITICAL(&g_poolSelMux);
+  return n;
+}
+
+void requestPoolProbe() {
+  pool_nodes_copy_();
+  g_poolProbeNow = true;
+  if (g_poolTask) xTaskNotifyGive(g_poolTask);
+}
+
+int getMiningJobs(MiningJobRecord* out, int max, uint32_t* lastSeq) {
+  portENTER_CRITICAL(&g_jobMux);
+  const uint32_t seq = g_jobSeq;
+  uint32_t n = (seq < (uint32_t)MC_DUCO_JOB_RING) ? seq : (uint32_t)MC_DUCO_JOB_RING;
+  if (max < 0) max = 0;
+  if (n > (uint32_t)max) n = (uint32_t)max;
+  for (uint32_t i = 0; i < n; ++i) out[i] = g_jobRing[(seq - 1 - i) % MC_DUCO_JOB_RING];
+  portEXIT_CRITICAL(&g_jobMux);
+  if (lastSeq) *lastSeq = seq;
+  return (int)n;
+}
+
+void setMiningTrace(MiningTraceMode m) {
+  g_traceWant = (uint8_t)m;
+  if (g_ioTask) xTaskNotifyGive(g_ioTask);
+}
+
+MiningTraceMode getMiningTrace() {
+  return (MiningTraceMode)g_traceWant;
+}
+
+int dumpMiningTrace(Print& out) {
+  if (g_traceWant == MINING_TRACE_FS || g_traceMode == MINING_TRACE_FS) return -1;
+  if (!LittleFS.begin(true)) return -1;
+  File f = LittleFS.open(kTracePath, "r");
+  if (!f) return -1;
+  uint8_t hdr[DUCO_TRACE_HDR_SIZE];
+  if (f.read(hdr, sizeof(hdr)) != sizeof(hdr) || !duco_trace_check_header(hdr, sizeof(hdr))) {
+    f.close();
+    return -1;
+  }
+  int n = 0;
+  uint8_t rec[DUCO_TRACE_REC_SIZE];
+  char    hex[DUCO_TRACE_REC_SIZE * 2 + 1];
+  while (f.read(rec, sizeof(rec)) == sizeof(rec)) {
+    duco_trace_to_hex(rec, hex);
+    out.printf("@TRC %s\n", hex);
+    ++n;
+  }
+  f.close();
+  return n;
+}
+
+bool clearMiningTrace() {
+  if (g_traceWant == MINING_TRACE_FS || g_traceMode == MINING_TRACE_FS) return false;
+  if (!LittleFS.begin(true)) return false;
+  if (LittleFS.exists(kTracePath)) LittleFS.remove(kTracePath);
+  return true;
+}
+
+void getMiningLifetime(MiningLifetime& out) {
+  portENTER_CRITICAL(&g_lifeMux);
+  const DucoLifeRecord r = g_lifeNow;
+  portEXIT_CRITICAL(&g_lifeMux);
+  out.boots     = r.boots;
+  out.accepted  = r.accepted;
+  out.rejected  = r.rejected;
+  out.hashes    = r.hashes;
+  out.uptime_s  = r.uptime_s;
+  out.mining_s  = r.mining_s;
+  out.seq       = r.seq;
+  out.flushes   = g_lifeFlushes;
+  out.persisted = g_lifeFs;
+}
+
+void requestMiningLifetimeFlush() {
+  g_lifeFlushReq = true;
+}
+
+void getMiningHashrateSeries(MiningHashrateSeries& out) {
+  portENTER_CRITICAL(&g_hrMux);
+  out.ewma_kh  = g_hrSeries.ewma_kh;
+  out.nMinutes = (uint8_t)g_hrSeries.minutes.copy(out.minutes, DUCO_HR_MINUTES);
+  out.nHours   = (uint8_t)g_hrSeries.hours.copy(out.hours, DUCO_HR_HOURS);
+  portEXIT_CRITICAL(&g_hrMux);
+}
+
+void setMiningHashratePolicy(MiningHashratePolicy p) {
+  g_hrPolicy = (uint8_t)p;
+  duco_io_set_hps_compute(p == MINING_HR_COMPUTE);
+}
+
+MiningHashratePolicy getMiningHashratePolicy() {
+  return (MiningHashratePolicy)g_hrPolicy;
+}
+
+void setMiningCooperative(bool on) {
+  g_coop_mode = on;
+}
+
+bool isMiningCooperative() {
+  return g_coop_mode;
+}
+
 void setMiningYieldProfile(MiningYieldProfile p) {
   // normalize 'every' to power-of-two (fast bitmask check)
   p.every = normalize_pow2(p.every);
@@ -2,18 +2,61 @@
 #pragma once
 #include <Arduino.h>
 
+#include "duco_hr_series.h"
+#include "duco_pool_select.h"
+
+// ★追加: 遅れの分布の要約 [ms]（duco_latency_hist。まだ 1 件も無ければ -1）
+struct MiningLatency {
+  float    p50 = -1.0f;
+  float    p95 = -1.0f;
+  float    p99 = -1.0f;
+  float    max = -1.0f;
+  uint32_t n   = 0;
+};
+
+// ★追加: 起動をまたいだ通算（duco_lifetime。LittleFS の /duco_life.bin）
+struct MiningLifetime {
+  uint32_t boots     = 0;
+  uint32_t accepted  = 0;
+  uint32_t rejected  = 0;
+  uint64_t hashes    = 0;
+  uint32_t uptime_s  = 0;       // 電源が入っていた時間
+  uint32_t mining_s  = 0;       // そのうちワーカーがハッシュを回していた時間（一時停止中は除く）
+  uint32_t seq       = 0;       // 最後に書いたスロットの seq
+  uint32_t flushes   = 0;       // この起動で書いた回数
+  bool     persisted = false;   // LittleFS に書けている（false なら RAM だけ）
+};
+
 // マイニングスレッドから集計して UI 側に渡すための構造体
 struct MiningSummary {
-  // 合計ハッシュレート [kH/s]
+  // 合計ハッシュレート [kH/s]（★変更: hashratePolicy で選んだ方。下の2つのどちらか）
   float    total_kh;
+  // ★追加: 実時間で割った値（yield / 一時停止 / 他タスクの横取りを含む）と
+  //         計算時間で割った値（yield と一時停止を除く）。差が開いたらスケジューリング側の問題
+  float    total_kh_wall    = 0.0f;
+  float    total_kh_compute = 0.0f;
+  uint8_t  hashratePolicy   = 0;   // MiningHashratePolicy
+  float    total_kh_ewma    = 0.0f;   // ★追加: total_kh を 1 秒ごとに取って EWMA でならした値
+
+  // ★追加: 全接続の遅れの分布（起動から。タイムアウトも入る）
+  MiningLatency latJob;        // JOB → ジョブ
+  MiningLatency latFeedback;   // submit → GOOD / BAD
+  MiningLatency latConnect;    // connect → banner
 
   // 受理・却下されたシェアの数
   uint32_t accepted;
   uint32_t rejected;
+  MiningLifetime lifetime;   // ★追加: 起動をまたいだ通算（1 秒ごとに更新）
 
-  // スレッドの中で観測された最大 ping [ms]
+  // スレッドの中で観測された最大 ping [ms]（JOB を送ってからジョブが届くまで）
   float    maxPingMs = 0.0f;
 
+  // ★追加: ping とは別に測った時間 [ms]（接続 / ワーカーごとの直近値の最大）
+  float    maxFeedbackMs = 0.0f;   // submit を送ってから GOOD / BAD が届くまで
+  float    maxSolveMs    = 0.0f;   // ワーカーがジョブを解くのにかかった時間
+  float    maxTurnMs     = 0.0f;   // 結果を受け取ってから次のジョブが届くまで
+  bool     pipelined     = false;  // submit と次の JOB をまとめて送るモード
+
   // スレッドの中で観測された最大 difficulty
   uint32_t maxDifficulty;
 
@@ -22,6 +65,13 @@ struct MiningSummary {
 
   // プール名（getPool API の name）
   String   poolName;
+  bool     poolCached = false;   // ★追加: 前回のノード（LittleFS のキャッシュ）で掘っている
+  uint32_t firstJobMs = 0;       // ★追加: 起動から最初のジョブが届くまで [ms]（0 = まだ）
+
+  // ★追加: プールノードのスコア（duco_pool_select。小さいほど良い / DUCO_POOL_SCORE_NONE = 未計測）
+  float    poolScore     = DUCO_POOL_SCORE_NONE;   // 今のノード
+  float    poolBestScore = DUCO_POOL_SCORE_NONE;   // 今のノード以外で一番良い候補
+  uint8_t  poolCandidates = 0;
 
   // ログ用 40文字以内の1行メッセージ
   String   logLine40;
@@ -29,6 +79,12 @@ struct MiningSummary {
   // ★追加: プール接続に関する診断メッセージ
   String   poolDiag;
 
+  // ★追加: 再開レイテンシ（setMiningPaused(false) / setMiningActiveThreads で
+  //         増やした合図から、待っていたワーカーが起きるまで）[us]
+  uint32_t resumeLatencyUs    = 0;   // 直近
+  uint32_t resumeLatencyMaxUs = 0;   // 起動後の最大
+  uint32_t resumeCount        = 0;   // 計測回数
+
   // ★追加: “本当に計算している” SHA1 演出用スナップショット
   // workSeed + nonce(10進) を SHA1 した結果が workHashHex（40桁hex）
   uint8_t  workThread      = 255;   // 0/1..（不明なら255）
@@ -47,6 +103,11 @@ void startMiner();
 // スレッドごとの統計を集計して UI 用のサマリに詰める
 void updateMiningSummary(MiningSummary& out);
 
+// ★追加: SHA1 演出用スナップショット（work*）を1つ要求する。
+// 次に制御ポイントに来た solver が埋め、以降の updateMiningSummary に載る。
+// 呼ばなければ solver はスナップショットを作らない（画面が見えていないときは呼ばないこと）
+void requestMiningWorkSample();
+
 // マイニングを「捨てずに」一時停止/再開する（JOB・接続は維持）
 void setMiningPaused(bool paused);
 bool isMiningPaused();
@@ -57,6 +118,8 @@ bool isMiningPaused();
 //   0 = stop/pause (all miners idle)
 //   1 = half (one miner thread)
 //   2 = full (default)
+//   無効になったスレッドは接続を保ったまま計算中のジョブを停め、有効に戻るとその続きから回す
+//   （サーバーが接続を切っていた場合だけ再接続して新しいジョブをもらう）
 // yieldProfile:
 //   every N nonces -> vTaskDelay(delay_ms)
 //   ※ every should be power-of-two for best speed (e.g. 1024, 256, 64)
@@ -74,6 +137,92 @@ struct MiningYieldProfile {
 
 void setMiningActiveThreads(uint8_t activeThreads);
 uint8_t getMiningActiveThreads();
+// ★追加: 起動したワーカー数（mc_config_store: miner_threads。setMiningActiveThreads の上限）
+uint8_t getMiningWorkerCount();
+
+// 協調モード: 1つのジョブの nonce 範囲を有効な全ワーカーで分担する。
+// 接続はスレッド0だけが持ち、最初に見つけたワーカーで他を打ち切ってスレッド0の接続から submit する。
+// （有効スレッドが1本のときは通常どおり）
+void setMiningCooperative(bool on);
+bool isMiningCooperative();
+
+// ★追加: パイプライン: シェアを submit したら GOOD / BAD を待たずに次の JOB も送る。
+// 返事は送った順（feedback → job）に読み、ジョブが届いた時点でワーカーに渡す
+void setMiningPipelined(bool on);
+bool isMiningPipelined();
+
+// ★追加: 表示と submit に使うハッシュレートの選び方（MC_DUCO_HASHRATE_POLICY）
+enum MiningHashratePolicy : uint8_t {
+  MINING_HR_WALL = 0,   // 実時間で割る
+  MINING_HR_COMPUTE,    // 計算時間（yield / 一時停止を除く）で割る
+};
+void                 setMiningHashratePolicy(MiningHashratePolicy p);
+MiningHashratePolicy getMiningHashratePolicy();
+
+// ★追加: ハッシュレートの時系列（I/O タスクが 1 秒ごとに、その間に全ワーカーが実際に回した数から出した
+// kH/s を duco_hr_series に足す。一時停止中などで回していなければ 0。実時間で割るので hashratePolicy に依らない）
+struct MiningHashrateSeries {
+  float   ewma_kh = 0.0f;
+  float   minutes[DUCO_HR_MINUTES];   // 1 分平均（古い順）
+  uint8_t nMinutes = 0;
+  float   hours[DUCO_HR_HOURS];       // 1 時間平均（古い順）
+  uint8_t nHours = 0;
+};
+void getMiningHashrateSeries(MiningHashrateSeries& out);
+
+// ★追加: 通算カウンタ。書くのは時間 / シェアの増分がしきい値を超えたときだけ
+// （MC_DUCO_LIFE_FLUSH_S / MC_DUCO_LIFE_FLUSH_SHARES）。request... は次の 1 秒で必ず書かせる（再起動 / OTA の前など）
+void getMiningLifetime(MiningLifetime& out);
+void requestMiningLifetimeFlush();
+
+// ★追加: プールノードの候補表の写し（out に最大 max 件。戻り値は件数、*cur は今のノードの番号 / -1）
+int  getPoolCandidates(DucoPoolCand* out, int max, int* cur);
+// 候補をすぐ測り直す（SET pool_nodes の後など）。乗り換えるかは測り終えてから決まる
+// 設定の pool_nodes はここで写すので、設定を書き換えるタスク（ループ）から呼ぶこと
+void requestPoolProbe();
+
+// ★追加: 直近のジョブの記録（I/O タスクが feedback まで揃ったところで RAM のリングに 1 件書く）
+// result は duco_trace の feedback と同じ値 + DROP
+enum MiningJobResult : uint8_t {
+  MINING_JOB_GOOD = 0,
+  MINING_JOB_BLOCK,
+  MINING_JOB_BAD,
+  MINING_JOB_NONE,    // 範囲内に答えが無かった
+  MINING_JOB_LOST,    // submit したが feedback の前に切れた / タイムアウト
+  MINING_JOB_DROP,    // 停めたまま古くなって捨てた
+};
+struct MiningJobRecord {
+  uint32_t seq        = 0;   // 通し番号（1 から）
+  uint32_t end_ms     = 0;   // 記録した時刻（millis）
+  uint32_t difficulty = 0;
+  uint32_t hashes     = 0;   // 回した数（停めていた分も含む）
+  uint32_t compute_us = 0;   // 解いていた時間（yield / 一時停止を除く）
+  uint32_t wall_us    = 0;   // キューに積んでから結果が返るまで（キュー待ち・停止を含む）
+  uint32_t pause_us   = 0;   // 停めていた時間
+  uint16_t ping_ms    = 0;   // JOB を送ってからジョブが届くまで
+  uint16_t fb_ms      = 0;   // submit から feedback まで（submit していなければ 0）
+  uint8_t  thread     = 0;   // 解いたワーカー
+  uint8_t  conn       = 0;
+  uint8_t  result     = MINING_JOB_NONE;
+};
+// 新しい順に最大 max 件を out へ（戻り値は件数）。*lastSeq に一番新しい seq（0 = まだ無い）
+int getMiningJobs(MiningJobRecord* out, int max, uint32_t* lastSeq);
+
+// ★追加: ジョブのトレース（duco_trace。1 ジョブ = 1 レコード、feedback まで揃ったところで書く）
+//   FS     : LittleFS の /duco_trace.bin に追記（MC_DUCO_TRACE_MAX_BYTES で止まる）
+//   SERIAL : "@TRC <hex>" を 1 行ずつ流す
+// 読み出しは test/duco-replay（同じジョブ列を好きなカーネルで解き直す）
+enum MiningTraceMode : uint8_t {
+  MINING_TRACE_OFF = 0,
+  MINING_TRACE_FS,
+  MINING_TRACE_SERIAL,
+};
+void            setMiningTrace(MiningTraceMode m);
+MiningTraceMode getMiningTrace();
+// /duco_trace.bin を "@TRC <hex>" で out へ（戻り値は件数。FS に書いている間 / ファイルが無ければ -1）
+int  dumpMiningTrace(Print& out);
+// /duco_trace.bin を消す（FS に書いている間は false）
+bool clearMiningTrace();
 
 void setMiningYieldProfile(MiningYieldProfile p);
 MiningYieldProfile getMiningYieldProfile();
@@ -807,7 +807,7 @@ void UIMining::handlePageInput(bool suppressTouchBeep) {
 
     if (x >= X_INF && x < X_INF + INF_W &&
         y >= 0     && y < INF_H) {
-      info_page_    = (info_page_ + 1) % 3;
+      info_page_    = (info_page_ + 1) % INFO_PAGES;
       last_page_ms_ = millis();
     }
   }
@@ -10,7 +10,7 @@
 //   Font0 x2 (approx 12x16 cell), 14 cols x 4 rows + header
 //   Label 4 chars + space + value up to 9 chars
 //   Header title centered + 3-dot indicator
-//   Pages: 0 MINING, 1 DEVICE, 2 NETWORK
+//   Pages: 0 MINING, 1 DEVICE, 2 NETWORK（★遅れの p50/p95/p99 も）, 3 HASH TREND（★追加: 直近 60 分 / 24 時間のスパークライン）
 //   Tap inside right panel => next page
 //
 // Anti-flicker:
@@ -24,6 +24,8 @@
 #include <M5GFX.h>
 #include <math.h>
 
+#include "duco_hr_series.h"
+
 class UIMining {
 public:
   struct PanelData {
@@ -50,6 +52,18 @@ public:
     // ★追加: 起動スプラッシュ用の診断メッセージ
     String   wifiDiag;
     String   poolDiag;
+
+    // ★追加: ハッシュレートの時系列（HASH TREND ページ。固定長なのでフレームごとの確保なし）
+    float    hr_ewma_kh   = 0.0f;
+    float    hr_minutes[DUCO_HR_MINUTES];   // 1 分平均（古い順）
+    uint8_t  hr_minutes_n = 0;
+    float    hr_hours[DUCO_HR_HOURS];       // 1 時間平均（古い順）
+    uint8_t  hr_hours_n   = 0;
+
+    // ★追加: 遅れの分布 [ms]（NETWORK ページ。p50 / p95 / p99、まだ無ければ -1）
+    float    lat_job[3]  = {-1.0f, -1.0f, -1.0f};   // JOB → ジョブ
+    float    lat_fb[3]   = {-1.0f, -1.0f, -1.0f};   // submit → GOOD / BAD
+    float    lat_conn[3] = {-1.0f, -1.0f, -1.0f};   // connect → banner
   };
 
 
@@ -157,10 +171,12 @@ private:
   static constexpr int IND_R = 2;
   static constexpr int IND_Y = 12;
 
-  // abs 302/308/314 -> rel 158/164/170
-  static constexpr int IND_X1 = 158;
-  static constexpr int IND_X2 = 164;
-  static constexpr int IND_X3 = 170;
+  // ★変更: ページが 4 つになったのでドットも 4 つ（abs 296/302/308/314 -> rel 152/158/164/170）
+  static constexpr int INFO_PAGES = 4;
+  static constexpr int IND_X1 = 152;
+  static constexpr int IND_X2 = 158;
+  static constexpr int IND_X3 = 164;
+  static constexpr int IND_X4 = 170;
 
   static constexpr uint16_t COL_LABEL = 0xC618; // light grey
   static constexpr uint16_t COL_DARK  = 0x4208;
@@ -277,6 +293,11 @@ private:
   // ---------- Line primitive ----------
   void drawLine(int y, const char* label4, const String& value,
                 uint16_t colLabel, uint16_t colValue);
+  void drawLine(int y, const char* label4, const char* value,
+                uint16_t colLabel, uint16_t colValue);
+  // ★追加: 枠付きの折れ線（v は古い順に n 点。右端が一番新しい点、cap 点で枠の幅いっぱい）
+  void drawSparkline(int x, int y, int w, int h, const float* v, int n, int cap,
+                     const char* tag, uint16_t col);
 
   // ---------- Value formatters ----------
   String vHash(float kh) const;
@@ -311,7 +332,9 @@ private:
   void drawPage0(const PanelData& p);
   void drawPage1(const PanelData& p);
   void drawPage2(const PanelData& p);
+  void drawPage3(const PanelData& p);
   void drawPoolNameSmall(const TextLayoutY& ly, const String& name);
+  void drawLatencySmall(const TextLayoutY& ly, const PanelData& p);
 
   // ---------- Right panel draw ----------
   void drawInfo(const PanelData& p);
@@ -28,8 +28,8 @@ void UIMining::drawDots(const TextLayoutY& ly) {
   uint16_t active   = TFT_CYAN;
   uint16_t inactive = COL_DARK;
 
-  const int xs[3] = { IND_X1, IND_X2, IND_X3 };
-  for (int i = 0; i < 3; ++i) {
+  const int xs[INFO_PAGES] = { IND_X1, IND_X2, IND_X3, IND_X4 };
+  for (int i = 0; i < INFO_PAGES; ++i) {
     if (i == info_page_) info_.fillCircle(xs[i], ly.ind_y, IND_R, active);
     else                 info_.drawCircle(xs[i], ly.ind_y, IND_R, inactive);
   }
@@ -44,9 +44,12 @@ void UIMining::drawHeader(const char* title, const TextLayoutY& ly) {
   // ドットぶんを避けた安全幅を少し広めに確保
   int safe_w = INF_W - 30;
 
-  String t = title;
-  while (t.length() && info_.textWidth(t) > safe_w) {
-    t.remove(t.length() - 1);
+  // ★変更: String を作らずに切る（毎フレーム呼ばれるので確保しない）
+  char t[32];
+  snprintf(t, sizeof(t), "%s", title ? title : "");
+  size_t len = strlen(t);
+  while (len && info_.textWidth(t) > safe_w) {
+    t[--len] = '\0';
   }
 
   int tw = info_.textWidth(t);
@@ -63,24 +66,80 @@ void UIMining::drawHeader(const char* title, const TextLayoutY& ly) {
 
 void UIMining::drawLine(int y, const char* label4, const String& value,
                         uint16_t colLabel, uint16_t colValue) {
+  drawLine(y, label4, value.c_str(), colLabel, colValue);
+}
+
+// ★変更: 本体は char* 版（String を作らない）
+void UIMining::drawLine(int y, const char* label4, const char* value,
+                        uint16_t colLabel, uint16_t colValue) {
   info_.fillRect(0, y, INF_W, CHAR_H, BLACK);
 
   prepBodyFont();
 
   info_.setTextColor(colLabel, BLACK);
   info_.setCursor(X_LABEL, y);
-  String lab = String(label4);
-  while (lab.length() < 4) lab += ' ';
-  if (lab.length() > 4) lab = lab.substring(0, 4);
+  char lab[5];
+  snprintf(lab, sizeof(lab), "%-4.4s", label4 ? label4 : "");
   info_.print(lab);
 
   info_.setTextColor(colValue, BLACK);
   info_.setCursor(X_VALUE, y);
-  String v = value;
-  if (v.length() > 9) v = v.substring(0, 9);
+  char v[10];
+  snprintf(v, sizeof(v), "%s", value ? value : "");
   info_.print(v);
 }
 
+// ★追加: スパークライン（座標はすべて info_ の中。確保なし）
+void UIMining::drawSparkline(int x, int y, int w, int h, const float* v, int n, int cap,
+                             const char* tag, uint16_t col) {
+  info_.drawRect(x, y, w, h, COL_DARK);
+
+  info_.setFont(&fonts::Font0);
+  info_.setTextSize(1);
+  info_.setTextColor(COL_LABEL, BLACK);
+  info_.setCursor(x + 2, y + 2);
+  info_.print(tag);
+
+  if (n < 2 || cap < 2) {
+    info_.setCursor(x + w / 2 - 6, y + h / 2 - 4);
+    info_.print("--");
+    return;
+  }
+
+  float lo = v[0], hi = v[0];
+  for (int i = 1; i < n; ++i) {
+    if (v[i] < lo) lo = v[i];
+    if (v[i] > hi) hi = v[i];
+  }
+  // 平らなときも線が真ん中に来るように少し広げる
+  const float pad = (hi - lo > 0.02f * hi) ? (hi - lo) * 0.1f : (hi > 0.0f ? hi * 0.05f : 1.0f);
+  lo -= pad;
+  hi += pad;
+  if (lo < 0.0f) lo = 0.0f;
+
+  char b[16];
+  snprintf(b, sizeof(b), "%.1f", hi);
+  info_.setCursor(x + w - 2 - info_.textWidth(b), y + 2);
+  info_.print(b);
+  snprintf(b, sizeof(b), "%.1f", lo);
+  info_.setCursor(x + w - 2 - info_.textWidth(b), y + h - 10);
+  info_.print(b);
+
+  // 右詰め: 一番新しい点が右端、cap 点でちょうど枠の幅
+  const int gx = x + 1, gw = w - 3;
+  const int gy = y + 1, gh = h - 3;
+  int px = 0, py = 0;
+  for (int i = 0; i < n; ++i) {
+    const int slot = cap - n + i;
+    const int xx = gx + (slot * gw) / (cap - 1);
+    const int yy = gy + gh - (int)((v[i] - lo) / (hi - lo) * gh);
+    if (i) info_.drawLine(px, py, xx, yy, col);
+    px = xx;
+    py = yy;
+  }
+  info_.fillCircle(px, py, 1, WHITE);
+}
+
 // ===== Value formatters =====
 
 String UIMining::vHash(float kh) const {
@@ -386,15 +445,66 @@ void UIMining::drawPage2(const PanelData& p) {
   // ★4行目はラベルのみ
   drawLine(ly.y4, "POOL", "", COL_LABEL, WHITE);
 
-  // ★プール名は下に小さく表示
+  // ★変更: プール名はラベルの右に小さく（下は遅れの分布に使う）
   drawPoolNameSmall(ly, p.poolName);
+  drawLatencySmall(ly, p);
+}
+
+// ★追加: 遅れの分布（p50 / p95 / p99 [ms]）をサイズ1で 4 行
+void UIMining::drawLatencySmall(const TextLayoutY& ly, const PanelData& p) {
+  int y = ly.y4 + CHAR_H + 4;   // 4行目の下
+
+  info_.setFont(&fonts::Font0);
+  info_.setTextSize(1);
+  info_.setTextColor(COL_LABEL, BLACK);
+  info_.setCursor(PAD_LR, y);
+  info_.print("ms      p50    p95    p99");
+
+  const float* rows[3] = {p.lat_job, p.lat_fb, p.lat_conn};
+  static const char* kLabel[3] = {"JOB ", "FB  ", "CONN"};
+  for (int r = 0; r < 3; ++r) {
+    y += 9;
+    char line[32];
+    int  o = snprintf(line, sizeof(line), "%s", kLabel[r]);
+    for (int i = 0; i < 3; ++i) {
+      const float v = rows[r][i];
+      if (v < 0.0f) o += snprintf(line + o, sizeof(line) - o, "  %5s", "--");
+      else          o += snprintf(line + o, sizeof(line) - o, "  %5u", (unsigned)(v + 0.5f));
+    }
+    // p99 がタイムアウト（10 s）の半分を超えたら目立たせる
+    const bool slow = rows[r][2] >= 5000.0f;
+    info_.setTextColor(slow ? 0xFD20 : WHITE, BLACK);
+    info_.setCursor(PAD_LR, y);
+    info_.print(line);
+  }
+}
+
+// ★追加: ハッシュレートの推移（EWMA + 直近 60 分 / 24 時間）
+void UIMining::drawPage3(const PanelData& p) {
+  auto ly = computeTextLayoutY();
+  drawHeader("HASH TREND", ly);
+
+  char b[16];
+  const float kh = p.hr_ewma_kh;
+  if (kh < 10.0f)       snprintf(b, sizeof(b), " %.2fkH/s", kh);
+  else if (kh < 100.0f) snprintf(b, sizeof(b), " %.1fkH/s", kh);
+  else                  snprintf(b, sizeof(b), " %.0fkH/s", kh);
+  drawLine(ly.y1, "AVG ", b, COL_LABEL, TFT_CYAN);
+
+  const int x = PAD_LR;
+  const int w = INF_W - PAD_LR * 2;
+  const int h = 44;
+  const int y1 = ly.y1 + CHAR_H + 8;
+  drawSparkline(x, y1, w, h, p.hr_minutes, p.hr_minutes_n, (int)DUCO_HR_MINUTES, "60m", TFT_CYAN);
+  drawSparkline(x, y1 + h + 10, w, h, p.hr_hours, p.hr_hours_n, (int)DUCO_HR_HOURS, "24h", 0xFD20);
 }
 
 void UIMining::drawPoolNameSmall(const TextLayoutY& ly, const String& name) {
-  int y = ly.y4 + CHAR_H + 6;  // 4行目の下
+  int y = ly.y4 + 4;  // ★変更: 4行目のラベルの右（文字の縦中央に合わせる）
+  const int x = X_VALUE;
 
   // サイズ1の1行ぶんをクリア
-  info_.fillRect(0, y, INF_W, 10, BLACK);
+  info_.fillRect(x, y, INF_W - x, 8, BLACK);
 
   info_.setFont(&fonts::Font0);
   info_.setTextSize(1);
@@ -403,12 +513,12 @@ void UIMining::drawPoolNameSmall(const TextLayoutY& ly, const String& name) {
   String s = name.length() ? name : String("--");
 
   // 横幅に収まるまで切る（安全）
-  int max_w = INF_W - PAD_LR * 2;
+  int max_w = INF_W - x - PAD_LR;
   while (s.length() && info_.textWidth(s) > max_w) {
     s.remove(s.length() - 1);
   }
 
-  info_.setCursor(PAD_LR, y);
+  info_.setCursor(x, y);
   info_.print(s);
 }
 
@@ -421,7 +531,8 @@ void UIMining::drawInfo(const PanelData& p) {
   switch (info_page_) {
     case 0: drawPage0(p); break;
     case 1: drawPage1(p); break;
-    default: drawPage2(p); break;
+    case 2: drawPage2(p); break;
+    default: drawPage3(p); break;
   }
 
   info_.pushSprite(X_INF, 0);
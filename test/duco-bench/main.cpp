@@ -0,0 +1,848 @@
+// test/duco-bench/main.cpp
+// ===== DUCO-S1 ホスト用マイクロベンチ =====
+// PC 上で nonce 生成とカーネルの速さを比べる（実機のハッシュレートとは別物）。
+//   pio run -e duco-bench -t exec
+// 引数: [nonce 数]（省略時 2,000,000） / kat（既知解テストだけ。外れたら終了コード 1）
+//       / proto（プロトコルコーデックのテストだけ。外れたら終了コード 1）
+//       / pool（プールノードの順位付けのテストだけ。ループバックに立てた代わりのサーバーを測る）
+//       / hr（ハッシュレートの時系列のテストだけ） / lat（遅れのヒストグラムのテストだけ）
+//       / life（通算カウンタのスロットのテストだけ） / trace（ジョブのトレースの往復だけ）
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+
+#include "duco_s1.h"
+#include "duco_s1_kernels.h"
+#include "duco_s1_kat.h"
+#include "duco_proto.h"
+#include "duco_pool_select.h"
+#include "duco_hr_series.h"
+#include "duco_latency_hist.h"
+#include "duco_lifetime.h"
+#include "duco_trace.h"
+
+static const char* kSeed = "d6f4c64a3a4cd3e8b2e1e57a6e3f1d1b4e0cbd07";
+
+static double nowSec() {
+  using namespace std::chrono;
+  return duration_cast<duration<double> >(
+           steady_clock::now().time_since_epoch()).count();
+}
+
+static void report(const char* name, uint32_t n, double sec, uint32_t check) {
+  printf("%-28s %10.0f /s  (%.3fs, check=%08x)\n",
+         name, n / (sec > 0 ? sec : 1e-9), sec, (unsigned)check);
+}
+
+// ---------- nonce 生成だけ ----------
+static void benchFormat(uint32_t n) {
+  char d[16];
+  uint32_t check = 0;
+
+  double t0 = nowSec();
+  for (uint32_t nonce = 0; nonce < n; ++nonce) {
+    int len = duco_s1_u32_to_dec(d, nonce);
+    check += (uint32_t)d[len - 1] + (uint32_t)len;
+  }
+  report("format: u32_to_dec", n, nowSec() - t0, check);
+
+  check = 0;
+  size_t len = (size_t)duco_s1_u32_to_dec(d, 0);
+  t0 = nowSec();
+  for (uint32_t nonce = 0; nonce < n; ++nonce) {
+    check += (uint32_t)d[len - 1] + (uint32_t)len;
+    duco_s1_nonce_inc(d, len);
+  }
+  report("format: odometer", n, nowSec() - t0, check);
+}
+
+// ---------- nonce 生成 + SHA1 ----------
+static void benchHash(uint32_t n) {
+  DucoS1Job job;
+  duco_s1_prepare(job, kSeed, strlen(kSeed));
+
+  char d[16];
+  uint8_t out[20];
+  uint32_t check = 0;
+
+  double t0 = nowSec();
+  for (uint32_t nonce = 0; nonce < n; ++nonce) {
+    int len = duco_s1_u32_to_dec(d, nonce);
+    duco_s1_hash(job, d, (size_t)len, out);
+    check ^= out[0] | (out[19] << 8);
+  }
+  report("hash: u32_to_dec + full", n, nowSec() - t0, check);
+
+  DucoS1Msg msg;
+  check = 0;
+  size_t len = (size_t)duco_s1_u32_to_dec(d, 0);
+  size_t changed = 0;
+  t0 = nowSec();
+  for (uint32_t nonce = 0; nonce < n; ++nonce) {
+    duco_s1_hash(job, msg, d, len, changed, out);
+    check ^= out[0] | (out[19] << 8);
+    changed = duco_s1_nonce_inc(d, len);
+  }
+  report("hash: odometer + cached", n, nowSec() - t0, check);
+
+  // 実際の solver と同じ「expected と比べるだけ」（ラウンド 75 で早期棄却）
+  uint8_t expected[20];
+  memset(expected, 0xA5, sizeof(expected));  // 当たらない target
+  duco_s1_set_target(job, expected);
+
+  DucoS1Msg msg2;
+  check = 0;
+  len = (size_t)duco_s1_u32_to_dec(d, 0);
+  changed = 0;
+  t0 = nowSec();
+  for (uint32_t nonce = 0; nonce < n; ++nonce) {
+    check += duco_s1_match(job, msg2, d, len, changed) ? 1u : 0u;
+    changed = duco_s1_nonce_inc(d, len);
+  }
+  report("match: odometer + reject", n, nowSec() - t0, check);
+}
+
+// ---------- 範囲走査（solver と同じ入口）：レーン数の比較 ----------
+typedef uint32_t (*ScanFn)(const DucoS1Job&, uint32_t, uint32_t,
+                           uint32_t&, DucoS1Control&);
+
+static void benchScanOne(const char* name, ScanFn fn, uint32_t n) {
+  DucoS1Job job;
+  duco_s1_prepare(job, kSeed, strlen(kSeed));
+  uint8_t expected[20];
+  memset(expected, 0xA5, sizeof(expected));  // 当たらない target = 最後まで走る
+  duco_s1_set_target(job, expected);
+
+  DucoS1Control ctl;
+  uint32_t hashes = 0;
+  double t0 = nowSec();
+  uint32_t r = fn(job, 0, n - 1, hashes, ctl);
+  report(name, hashes, nowSec() - t0, r);
+}
+
+static void benchScan(uint32_t n) {
+  benchScanOne("scan: scalar", duco_s1_scan, n);
+  benchScanOne("scan: interleaved x2", duco_s1_scan_interleaved<2>, n);
+  benchScanOne("scan: interleaved x4", duco_s1_scan_interleaved<4>, n);
+
+  // SIMD 版（-march=native で使える命令セットに応じて中身が変わる）
+  char name[64];
+  snprintf(name, sizeof(name), "scan: vector x4 (%s)", duco_s1_vector_backend<4>());
+  benchScanOne(name, duco_s1_scan_vector<4>, n);
+  snprintf(name, sizeof(name), "scan: vector x8 (%s)", duco_s1_vector_backend<8>());
+  benchScanOne(name, duco_s1_scan_vector<8>, n);
+  snprintf(name, sizeof(name), "scan: vector x16 (%s)", duco_s1_vector_backend<16>());
+  benchScanOne(name, duco_s1_scan_vector<16>, n);
+}
+
+// ---------- 答え合わせ（proto / pool / hr / lat / life / trace で共通） ----------
+// 外れたら 1 行出して数える。各テストは始めた時点の g_fail と比べて ok / FAIL を決める
+static int g_fail = 0;
+
+static void check(const char* suite, bool ok, const char* what) {
+  if (!ok) {
+    printf("%s: FAIL %s\n", suite, what);
+    ++g_fail;
+  }
+}
+
+static bool suiteDone(const char* suite, int fail0) {
+  const bool ok = (g_fail == fail0);
+  printf("%s: %s\n", suite, ok ? "ok" : "FAIL");
+  return ok;
+}
+
+// ---------- 既知解テスト（実機の startMiner と同じベクタ）：全カーネル ----------
+// 1つでも外れたら false（main は終了コード 1 を返す）
+static bool runKat() {
+  bool allOk = true;
+  for (size_t i = 0; i < duco_s1_kernel_count(); ++i) {
+    const DucoS1Kernel* k = duco_s1_kernel_at(i);
+    DucoS1KatFailure f;
+    if (duco_s1_kat_run(k->scan, &f)) {
+      printf("kat: %-22s ok (%u vectors)\n", k->name, (unsigned)duco_s1_kat_count());
+    } else {
+      printf("kat: %-22s FAIL vector=%d %s got=%u hashes=%u/%u\n",
+             k->name, f.index, f.negative ? "(miss window)" : "(hit window)",
+             (unsigned)f.got, (unsigned)f.hashes, (unsigned)f.want);
+      allOk = false;
+    }
+  }
+  return allOk;
+}
+
+// ---------- プロトコルコーデック（duco_proto）：答え合わせ ----------
+// 行を1バイトずつ流し込んで、揃った行を返す
+static bool protoFeed(DucoLineBuf& lb, const char* bytes, char* out, size_t cap) {
+  for (const char* p = bytes; *p; ++p) {
+    if (duco_line_push(lb, *p)) {
+      snprintf(out, cap, "%s", lb.buf);
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool runProto() {
+  const int fail0 = g_fail;
+  char got[256];
+
+  // ---- 行バッファ ----
+  {
+    DucoLineBuf lb;
+    check("proto", !protoFeed(lb, "3.0", got, sizeof(got)), "line: no newline yet");
+    check("proto", protoFeed(lb, "\r\n", got, sizeof(got)) && strcmp(got, "3.0") == 0,
+                   "line: split + CRLF");
+    check("proto", protoFeed(lb, "GOOD  \n", got, sizeof(got)) && strcmp(got, "GOOD") == 0,
+                   "line: trailing spaces");
+    check("proto", !lb.overflow, "line: no overflow");
+    for (int i = 0; i < 300; ++i) duco_line_push(lb, 'x');
+    size_t n = 0;
+    check("proto", duco_line_push(lb, '\n', &n) && lb.overflow && n == DUCO_PROTO_LINE_MAX - 1,
+                   "line: overflow is truncated and flagged");
+    check("proto", protoFeed(lb, "BAD\n", got, sizeof(got)) && !lb.overflow, "line: overflow clears");
+  }
+
+  // ---- banner ----
+  {
+    char line[] = "  4.3 ";
+    const char* v = nullptr;
+    check("proto", duco_parse_banner(line, &v) && strcmp(v, "4.3") == 0, "banner");
+    char empty[] = "   ";
+    check("proto", !duco_parse_banner(empty, &v), "banner: empty");
+  }
+
+  // ---- job ----
+  {
+    const DucoS1KatVector& kv = duco_s1_kat_at(0);
+    char line[DUCO_PROTO_LINE_MAX];
+    snprintf(line, sizeof(line), "%s,%s,%u", kv.prev, kv.expected, (unsigned)kv.difficulty);
+    DucoJobLine j;
+    bool ok = duco_parse_job(line, j);
+    check("proto", ok && j.prevLen == 40 && strcmp(j.prev, kv.prev) == 0, "job: prev");
+    check("proto", ok && j.difficulty == kv.difficulty, "job: difficulty");
+    char hex[41];
+    for (int i = 0; i < 20; ++i) snprintf(hex + i * 2, 3, "%02x", j.expected[i]);
+    check("proto", ok && strcasecmp(hex, kv.expected) == 0, "job: expected");
+
+    snprintf(line, sizeof(line), " %s , %s , 0 ", kv.prev, kv.expected);
+    check("proto", duco_parse_job(line, j) && j.prevLen == 40 && j.difficulty == 1,
+                   "job: spaces / difficulty 0 -> 1");
+
+    const char* bad[] = {
+      "abc,def",                                                       // 項目が足りない
+      ",0123456789012345678901234567890123456789,10",                  // prev が空
+      "abc,0123,10",                                                   // expected が短い
+      "abc,012345678901234567890123456789012345678g,10",               // hex でない
+      "abc,0123456789012345678901234567890123456789,",                 // difficulty が無い
+      "abc,0123456789012345678901234567890123456789,12x",              // difficulty が数でない
+      "abc,0123456789012345678901234567890123456789,99999999999",      // 32bit を超える
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); ++i) {
+      snprintf(line, sizeof(line), "%s", bad[i]);
+      char what[64];
+      snprintf(what, sizeof(what), "job: reject #%u", (unsigned)i);
+      check("proto", !duco_parse_job(line, j), what);
+    }
+  }
+
+  // ---- feedback ----
+  {
+    char a[] = "GOOD", b[] = "BLOCK", c[] = "BAD,Incorrect result", d[] = "BAD", e[] = "GOODBYE";
+    const char* why = nullptr;
+    check("proto", duco_parse_feedback(a) == DUCO_FB_GOOD, "feedback: GOOD");
+    check("proto", duco_parse_feedback(b) == DUCO_FB_BLOCK, "feedback: BLOCK");
+    check("proto", duco_parse_feedback(c, &why) == DUCO_FB_BAD && strcmp(why, "Incorrect result") == 0,
+                   "feedback: BAD,reason");
+    check("proto", duco_parse_feedback(d, &why) == DUCO_FB_BAD && strcmp(why, "") == 0, "feedback: BAD");
+    check("proto", duco_parse_feedback(e) == DUCO_FB_UNKNOWN, "feedback: unknown");
+    check("proto", duco_feedback_accepted(DUCO_FB_BLOCK) && !duco_feedback_accepted(DUCO_FB_BAD),
+                   "feedback: accepted");
+  }
+
+  // ---- 数値 ----
+  {
+    const uint32_t us[] = {0, 9, 10, 99999, 100000, 4294967295u};
+    for (size_t i = 0; i < sizeof(us) / sizeof(us[0]); ++i) {
+      char a[16], b[16];
+      a[duco_fmt_u32(a, us[i])] = '\0';
+      snprintf(b, sizeof(b), "%u", (unsigned)us[i]);
+      check("proto", strcmp(a, b) == 0, "fmt_u32");
+    }
+    const float fs[] = {0.0f, 0.004f, 0.006f, 1.5f, 123.456f, 98765.43f, 4.2e6f, -3.0f};
+    for (size_t i = 0; i < sizeof(fs) / sizeof(fs[0]); ++i) {
+      char a[32], b[32];
+      a[duco_fmt_fixed2(a, fs[i])] = '\0';
+      snprintf(b, sizeof(b), "%.2f", fs[i] > 0 ? (double)fs[i] : 0.0);
+      char what[96];
+      snprintf(what, sizeof(what), "fmt_fixed2 %s vs %s", a, b);
+      check("proto", strcmp(a, b) == 0, what);
+    }
+  }
+
+  // ---- 送信行 ----
+  {
+    char out[DUCO_PROTO_TX_MAX];
+    size_t n = duco_fmt_job_request(out, sizeof(out), "alice", "LOW", "None");
+    check("proto", n == strlen("JOB,alice,LOW,None\n") && strcmp(out, "JOB,alice,LOW,None\n") == 0,
+                   "job request");
+    n = duco_fmt_submit(out, sizeof(out), 123456, 41234.5f, "M5StackCore2", "0.681",
+                        "Mining-Stackchan-Core2", "ABCD12345678", 2048);
+    const char* want = "123456,41234.50,M5StackCore2 0.681,Mining-Stackchan-Core2,DUCOIDABCD12345678,2048\n";
+    check("proto", n == strlen(want) && strcmp(out, want) == 0, "submit");
+    char tiny[16];
+    check("proto", duco_fmt_submit(tiny, sizeof(tiny), 1, 1.0f, "b", "v", "r", "c", 1) == 0 &&
+                   tiny[0] == '\0', "submit: overflow -> 0");
+  }
+
+  return suiteDone("proto", fail0);
+}
+
+// ---------- プロトコルコーデック：速さ（1 シェアぶんの行を組み立てて / 解析して） ----------
+static void benchProto(uint32_t n) {
+  const DucoS1KatVector& kv = duco_s1_kat_at(0);
+  char jobLine[DUCO_PROTO_LINE_MAX];
+  const int jl = snprintf(jobLine, sizeof(jobLine), "%s,%s,%u\n",
+                          kv.prev, kv.expected, (unsigned)kv.difficulty);
+  uint32_t check = 0;
+
+  // 受信: 1バイトずつ行バッファへ + job 解析
+  DucoLineBuf lb;
+  DucoJobLine j;
+  double t0 = nowSec();
+  for (uint32_t i = 0; i < n; ++i) {
+    for (int b = 0; b < jl; ++b) {
+      if (duco_line_push(lb, jobLine[b]) && duco_parse_job(lb.buf, j)) {
+        check += j.difficulty + j.expected[i % 20];
+      }
+    }
+  }
+  report("proto: rx job line", n, nowSec() - t0, check);
+
+  // 送信: submit 行
+  char out[DUCO_PROTO_TX_MAX];
+  check = 0;
+  t0 = nowSec();
+  for (uint32_t i = 0; i < n; ++i) {
+    check += (uint32_t)duco_fmt_submit(out, sizeof(out), i, 41234.5f + (float)(i & 1023),
+                                       "M5StackCore2", "0.681", "Mining-Stackchan-Core2",
+                                       "ABCD12345678", 2048);
+  }
+  report("proto: tx submit line", n, nowSec() - t0, check);
+
+  // 比較用: snprintf で同じ submit 行
+  check = 0;
+  t0 = nowSec();
+  for (uint32_t i = 0; i < n; ++i) {
+    check += (uint32_t)snprintf(out, sizeof(out), "%u,%.2f,%s %s,%s,DUCOID%s,%u\n",
+                                (unsigned)i, 41234.5f + (float)(i & 1023),
+                                "M5StackCore2", "0.681", "Mining-Stackchan-Core2",
+                                "ABCD12345678", 2048u);
+  }
+  report("proto: tx submit (snprintf)", n, nowSec() - t0, check);
+}
+
+// ---------- プールノードの順位付け（duco_pool_select）：代わりのサーバーを測って答え合わせ ----------
+// 実機の DucoPool タスクと同じく「TCP connect → banner の1行が届くまで」を測る。
+// サーバーは 127.0.0.1 の空きポートで、繋がったら delayMs 待って banner を返して切る
+// （delayMs < 0 なら banner を返さない）
+struct StandInPool {
+  int         fd      = -1;
+  uint16_t    port    = 0;
+  int         delayMs = 0;
+  volatile bool stop  = false;
+  std::thread th;
+
+  bool start(int delay) {
+    delayMs = delay;
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    sockaddr_in a;
+    memset(&a, 0, sizeof(a));
+    a.sin_family      = AF_INET;
+    a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    a.sin_port        = 0;
+    socklen_t len = sizeof(a);
+    if (bind(fd, (sockaddr*)&a, sizeof(a)) != 0 || listen(fd, 8) != 0 ||
+        getsockname(fd, (sockaddr*)&a, &len) != 0) {
+      return false;
+    }
+    port = ntohs(a.sin_port);
+    th = std::thread([this]() {
+      for (;;) {
+        pollfd pf = {fd, POLLIN, 0};
+        if (poll(&pf, 1, 20) <= 0) {
+          if (stop) return;
+          continue;
+        }
+        const int c = accept(fd, nullptr, nullptr);
+        if (c < 0) continue;
+        if (delayMs >= 0) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+          const ssize_t w = write(c, "3.0\n", 4);
+          (void)w;
+        } else {
+          std::this_thread::sleep_for(std::chrono::milliseconds(400));
+        }
+        close(c);
+      }
+    });
+    return true;
+  }
+  void finish() {
+    stop = true;
+    if (th.joinable()) th.join();
+    if (fd >= 0) close(fd);
+  }
+};
+
+// 繋がらないポート（bind して閉じた直後のポート）
+static uint16_t closedPort() {
+  StandInPool p;
+  if (!p.start(0)) return 1;
+  const uint16_t port = p.port;
+  p.finish();
+  return port;
+}
+
+static bool probeLoopback(uint16_t port, int timeoutMs, float& connMs, float& bannerMs) {
+  const int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) return false;
+  sockaddr_in a;
+  memset(&a, 0, sizeof(a));
+  a.sin_family      = AF_INET;
+  a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  a.sin_port        = htons(port);
+
+  const double t0 = nowSec();
+  if (connect(fd, (sockaddr*)&a, sizeof(a)) != 0) {
+    close(fd);
+    return false;
+  }
+  const double t1 = nowSec();
+
+  DucoLineBuf lb;
+  bool got = false;
+  while (!got) {
+    const int left = timeoutMs - (int)((nowSec() - t1) * 1000.0);
+    pollfd pf = {fd, POLLIN, 0};
+    if (left <= 0 || poll(&pf, 1, left) <= 0) break;
+    char buf[64];
+    const ssize_t r = read(fd, buf, sizeof(buf));
+    if (r <= 0) break;
+    for (ssize_t i = 0; i < r && !got; ++i) got = duco_line_push(lb, buf[i]);
+  }
+  const double t2 = nowSec();
+  close(fd);
+
+  const char* ver = nullptr;
+  if (!got || !duco_parse_banner(lb.buf, &ver)) return false;
+  connMs   = (float)((t1 - t0) * 1000.0);
+  bannerMs = (float)((t2 - t1) * 1000.0);
+  return true;
+}
+
+static bool runPool() {
+  const int fail0 = g_fail;
+
+  // ---- pool_nodes の書式 ----
+  {
+    DucoPoolSel sel;
+    check("pool", duco_pool_parse_nodes("", &sel) == 0 && sel.n == 0, "nodes: empty");
+    check("pool", duco_pool_parse_nodes(" a.example:2811 , 10.0.0.2:6000", &sel) == 2 && sel.n == 2 &&
+                  strcmp(sel.c[0].host, "a.example") == 0 && sel.c[1].port == 6000 &&
+                  sel.c[0].origin == DUCO_POOL_FROM_USER, "nodes: two");
+    check("pool", duco_pool_parse_nodes("a:1,b", &sel) < 0 && sel.n == 2, "nodes: missing port");
+    check("pool", duco_pool_parse_nodes("a:70000", nullptr) < 0, "nodes: port range");
+    check("pool", duco_pool_parse_nodes("a b:1", nullptr) < 0, "nodes: bad host");
+    check("pool", duco_pool_parse_nodes("a:1,", nullptr) < 0, "nodes: trailing comma");
+  }
+
+  // ---- スコアと乗り換え（数値だけ） ----
+  {
+    DucoPoolSel sel;
+    const int a = duco_pool_sel_add(sel, "a", 1, "A", DUCO_POOL_FROM_GETPOOL);
+    const int b = duco_pool_sel_add(sel, "b", 1, "B", DUCO_POOL_FROM_GETPOOL);
+    check("pool", duco_pool_sel_add(sel, "a", 1, "A2", DUCO_POOL_FROM_GETPOOL) == a &&
+                  strcmp(sel.c[a].name, "A2") == 0, "add: dedupe");
+    check("pool", duco_pool_sel_best(sel) < 0 && duco_pool_sel_pick(sel, a, 0.25f, 0.0f) < 0,
+                  "unprobed: no pick");
+    duco_pool_sel_probe(sel, a, true, 40.0f, 60.0f);   // 100
+    duco_pool_sel_probe(sel, b, true, 40.0f, 50.0f);   // 90
+    check("pool", duco_pool_sel_best(sel) == b, "best: lower latency");
+    check("pool", duco_pool_sel_pick(sel, a, 0.25f, 0.0f) < 0, "pick: within margin -> stay");
+    duco_pool_sel_probe(sel, b, true, 10.0f, 10.0f);   // EWMA: 40 -> 31, 50 -> 38
+    check("pool", sel.c[b].connect_ms > 30.0f && sel.c[b].connect_ms < 32.0f, "probe: ewma");
+    check("pool", duco_pool_sel_pick(sel, a, 0.25f, 0.0f) == b, "pick: beyond margin -> switch");
+    check("pool", duco_pool_sel_pick(sel, a, 0.25f, 50.0f) < 0, "pick: gap too small -> stay");
+    for (int i = 0; i < 40; ++i) duco_pool_sel_share(sel, b, false);
+    check("pool", duco_pool_sel_best(sel) == a, "best: rejects count");
+    duco_pool_sel_probe(sel, a, false, 0, 0);
+    check("pool", duco_pool_sel_score(sel.c[a]) < DUCO_POOL_SCORE_NONE, "fail once: still usable");
+    duco_pool_sel_probe(sel, a, false, 0, 0);
+    check("pool", duco_pool_sel_score(sel.c[a]) >= DUCO_POOL_SCORE_NONE, "fail twice: dropped");
+    check("pool", duco_pool_sel_pick(sel, a, 0.25f, 1000.0f) == b, "pick: current dropped -> move");
+
+    // 一杯なら USER と keep 以外で一番悪いものを追い出す
+    DucoPoolSel full;
+    for (int i = 0; i < DUCO_POOL_MAX_CANDS; ++i) {
+      char h[8];
+      snprintf(h, sizeof(h), "h%d", i);
+      duco_pool_sel_add(full, h, 1, nullptr,
+                        i < 2 ? DUCO_POOL_FROM_USER : DUCO_POOL_FROM_GETPOOL);
+      duco_pool_sel_probe(full, i, true, 10.0f * (float)(i + 1), 0.0f);
+    }
+    const int last = DUCO_POOL_MAX_CANDS - 1;
+    const int got = duco_pool_sel_add(full, "new", 1, nullptr, DUCO_POOL_FROM_GETPOOL, last);
+    check("pool", got == last - 1 && full.n == DUCO_POOL_MAX_CANDS, "add: evict worst, keep current");
+  }
+
+  // ---- 代わりのサーバーを実際に測る ----
+  {
+    static const int kDelay[] = {60, 10, 30, -1};
+    const int ns = (int)(sizeof(kDelay) / sizeof(kDelay[0]));
+    StandInPool srv[ns];
+    DucoPoolSel sel;
+    bool up = true;
+    for (int i = 0; i < ns; ++i) {
+      up = up && srv[i].start(kDelay[i]);
+      char name[16];
+      snprintf(name, sizeof(name), "stand-in-%d", i);
+      duco_pool_sel_add(sel, "127.0.0.1", srv[i].port, name, DUCO_POOL_FROM_USER);
+    }
+    const int refused = duco_pool_sel_add(sel, "127.0.0.1", closedPort(), "refused",
+                                          DUCO_POOL_FROM_GETPOOL);
+    check("pool", up, "stand-in servers up");
+
+    for (int round = 0; round < 3; ++round) {
+      for (int i = 0; i < sel.n; ++i) {
+        float connMs = 0.0f, bannerMs = 0.0f;
+        const bool ok = probeLoopback(sel.c[i].port, 200, connMs, bannerMs);
+        duco_pool_sel_probe(sel, i, ok, connMs, bannerMs);
+      }
+    }
+    for (int i = 0; i < sel.n; ++i) {
+      const float sc = duco_pool_sel_score(sel.c[i]);
+      printf("pool: %-11s connect=%6.2f ms banner=%6.2f ms fails=%u score=%.1f\n",
+             sel.c[i].name, sel.c[i].connect_ms, sel.c[i].banner_ms,
+             (unsigned)sel.c[i].probe_fails, sc < DUCO_POOL_SCORE_NONE ? sc : -1.0f);
+    }
+    check("pool", duco_pool_sel_best(sel) == 1, "stand-in: fastest banner wins");
+    check("pool", duco_pool_sel_score(sel.c[3]) >= DUCO_POOL_SCORE_NONE, "stand-in: silent dropped");
+    check("pool", duco_pool_sel_score(sel.c[refused]) >= DUCO_POOL_SCORE_NONE,
+                  "stand-in: refused dropped");
+    check("pool", duco_pool_sel_pick(sel, 0, 0.25f, 30.0f) == 1, "stand-in: 60 ms -> 10 ms");
+    check("pool", duco_pool_sel_pick(sel, 2, 0.25f, 30.0f) < 0, "stand-in: 30 ms stays (gap)");
+
+    for (int i = 0; i < ns; ++i) srv[i].finish();
+  }
+
+  return suiteDone("pool", fail0);
+}
+
+// ---------- ハッシュレートの時系列（duco_hr_series） ----------
+static bool runHr() {
+  const int fail0 = g_fail;
+
+  // リング: 70 点入れたら最後の 60 点が古い順に出る
+  {
+    DucoHrRing<60> r;
+    float out[60];
+    check("hr", r.copy(out, 60) == 0, "ring: empty");
+    for (int i = 0; i < 70; ++i) r.push((float)i);
+    const size_t n = r.copy(out, 60);
+    check("hr", n == 60 && out[0] == 10.0f && out[59] == 69.0f, "ring: wraps, oldest first");
+    check("hr", r.copy(out, 5) == 5 && out[0] == 65.0f && out[4] == 69.0f, "ring: newest 5");
+  }
+
+  // 1 分平均 / 1 時間平均（1 秒ごと）
+  {
+    DucoHrSeries s;
+    uint32_t t = 1000;
+    for (int i = 0; i < 60; ++i, t += 1000) duco_hr_series_add(s, t, 100.0f, 60.0f);
+    check("hr", s.minutes.n == 0, "minute: not closed before 60 s");
+    duco_hr_series_add(s, t, 100.0f, 60.0f);
+    t += 1000;
+    float out[DUCO_HR_MINUTES];
+    check("hr", s.minutes.copy(out, DUCO_HR_MINUTES) == 1 && fabsf(out[0] - 100.0f) < 1e-3f,
+                "minute: mean of the first minute");
+    for (int i = 0; i < 3700; ++i, t += 1000) {
+      duco_hr_series_add(s, t, (i < 1800) ? 50.0f : 150.0f, 60.0f);
+    }
+    check("hr", s.hours.n == 1, "hour: closed after 60 minutes");
+    check("hr", s.minutes.n == DUCO_HR_MINUTES, "minute: ring full after an hour");
+  }
+
+  // EWMA: 0 -> 100 の段差で 1 時定数後に約 63 %。間隔が飛んでも同じ
+  {
+    DucoHrSeries a, b;
+    duco_hr_series_add(a, 0, 0.0f, 60.0f);
+    duco_hr_series_add(b, 0, 0.0f, 60.0f);
+    for (uint32_t t = 1000; t <= 60000; t += 1000) duco_hr_series_add(a, t, 100.0f, 60.0f);
+    for (uint32_t t = 3000; t <= 60000; t += 3000) duco_hr_series_add(b, t, 100.0f, 60.0f);
+    check("hr", fabsf(a.ewma_kh - 63.2f) < 0.5f, "ewma: one time constant");
+    check("hr", fabsf(a.ewma_kh - b.ewma_kh) < 0.01f, "ewma: independent of sample spacing");
+  }
+
+  // millis の折り返しをまたいでも 1 分で閉じる
+  {
+    DucoHrSeries s;
+    uint32_t t = 0xFFFFFFFFu - 30000u;
+    for (int i = 0; i <= 60; ++i, t += 1000) duco_hr_series_add(s, t, 10.0f, 60.0f);
+    check("hr", s.minutes.n == 1, "minute: across millis wrap");
+  }
+
+  return suiteDone("hr", fail0);
+}
+
+// ---------- 遅れのヒストグラム（duco_latency_hist） ----------
+static bool runLat() {
+  const int fail0 = g_fail;
+
+  // バケツの境界: 隙間なく並び、値はそのバケツの [lo, hi) に入る
+  {
+    bool ok = duco_lat_bucket_lo(0) == 0;
+    for (size_t i = 0; i + 1 < DUCO_LAT_BUCKETS; ++i) {
+      ok = ok && duco_lat_bucket_hi(i) == duco_lat_bucket_lo(i + 1) &&
+           duco_lat_bucket_lo(i) < duco_lat_bucket_hi(i);
+    }
+    check("lat", ok, "buckets: contiguous");
+    for (uint32_t ms = 0; ms <= DUCO_LAT_MAX_MS; ++ms) {
+      const size_t b = duco_lat_bucket(ms);
+      if (b >= DUCO_LAT_BUCKETS || ms < duco_lat_bucket_lo(b) || ms >= duco_lat_bucket_hi(b)) {
+        ok = false;
+        break;
+      }
+    }
+    check("lat", ok, "buckets: every ms in its own range");
+    check("lat", duco_lat_bucket(1000000) == DUCO_LAT_BUCKETS - 1, "buckets: clamp");
+  }
+
+  // 分位点: 1..1000 ms を一様に入れると p50 ≒ 500、p99 ≒ 990（誤差 12.5 % 以内）
+  {
+    DucoLatHist h;
+    check("lat", duco_lat_quantile(h, 0.5f) < 0.0f, "quantile: empty");
+    for (uint32_t ms = 1; ms <= 1000; ++ms) duco_lat_add(h, ms);
+    const float p50 = duco_lat_quantile(h, 0.50f);
+    const float p99 = duco_lat_quantile(h, 0.99f);
+    check("lat", fabsf(p50 - 500.0f) <= 500.0f * 0.125f, "quantile: p50");
+    check("lat", fabsf(p99 - 990.0f) <= 990.0f * 0.125f && p99 <= 1000.0f, "quantile: p99");
+    check("lat", duco_lat_quantile(h, 1.0f) <= 1000.0f, "quantile: never above max");
+  }
+
+  // 合算: 速い接続 + タイムアウトばかりの接続 -> p99 だけ尻尾に出る
+  {
+    DucoLatHist a, b, m;
+    for (int i = 0; i < 980; ++i) duco_lat_add(a, 40);
+    for (int i = 0; i < 20; ++i) duco_lat_add(b, 10000);
+    duco_lat_merge(m, a);
+    duco_lat_merge(m, b);
+    check("lat", m.count == 1000 && m.max_ms == 10000, "merge: count / max");
+    check("lat", duco_lat_quantile(m, 0.95f) < 50.0f, "merge: p95 stays fast");
+    check("lat", duco_lat_quantile(m, 0.99f) > 8000.0f, "merge: p99 shows the timeouts");
+    duco_lat_clear(m);
+    check("lat", m.count == 0 && duco_lat_quantile(m, 0.5f) < 0.0f, "clear");
+  }
+
+  return suiteDone("lat", fail0);
+}
+
+// ---------- 通算カウンタのスロット（duco_lifetime） ----------
+static bool runLife() {
+  const int fail0 = g_fail;
+
+  // CRC-32 の既知の値
+  check("life", duco_life_crc32((const uint8_t*)"123456789", 9) == 0xCBF43926u, "crc32: check value");
+
+  // 往復 / 1 ビット壊すと読めない
+  DucoLifeRecord a;
+  a.seq = 7; a.boots = 3; a.accepted = 12345; a.rejected = 67;
+  a.uptime_s = 86400; a.mining_s = 80000; a.hashes = 0x123456789ABCull;
+  uint8_t rec[DUCO_LIFE_REC_SIZE];
+  duco_life_encode(a, rec);
+  DucoLifeRecord b;
+  check("life", duco_life_decode(rec, b) && b.seq == 7 && b.boots == 3 && b.accepted == 12345 &&
+                b.rejected == 67 && b.uptime_s == 86400 && b.mining_s == 80000 &&
+                b.hashes == 0x123456789ABCull, "round trip");
+  rec[30] ^= 0x04;
+  check("life", !duco_life_decode(rec, b), "crc: flipped bit rejected");
+
+  // 空のファイル -> 無し、スロット 0 から
+  uint8_t file[DUCO_LIFE_FILE_SIZE];
+  memset(file, 0, sizeof(file));
+  DucoLifeRecord got;
+  int slot = duco_life_pick(file, sizeof(file), got);
+  check("life", slot == -1 && duco_life_next_slot(slot) == 0, "pick: empty file");
+
+  // 順に書いていく（一周 + 3）と、一番新しいスロットと次の位置が合う
+  DucoLifeRecord r;
+  size_t next = 0;
+  for (uint32_t i = 1; i <= DUCO_LIFE_SLOTS + 3; ++i) {
+    r.seq = i;
+    r.accepted = i * 10;
+    duco_life_encode(r, file + next * DUCO_LIFE_REC_SIZE);
+    next = duco_life_next_slot((int)next);
+  }
+  slot = duco_life_pick(file, sizeof(file), got);
+  check("life", slot == 2 && got.seq == DUCO_LIFE_SLOTS + 3 && got.accepted == (DUCO_LIFE_SLOTS + 3) * 10,
+                "pick: newest after wrap");
+  check("life", duco_life_next_slot(slot) == next, "pick: next slot");
+
+  // 書きかけで落ちた（一番新しいスロットが壊れた）-> 1 つ前から
+  file[2 * DUCO_LIFE_REC_SIZE + 5] ^= 0xFF;
+  slot = duco_life_pick(file, sizeof(file), got);
+  check("life", slot == 1 && got.seq == DUCO_LIFE_SLOTS + 2, "pick: torn write falls back");
+
+  // 短いファイル（途中まで）でも読めるところだけ
+  slot = duco_life_pick(file, DUCO_LIFE_REC_SIZE + 3, got);
+  check("life", slot == 0, "pick: short file");
+
+  // seq が 32 ビットを一周しても新しい方を選ぶ
+  memset(file, 0, sizeof(file));
+  r.seq = 0xFFFFFFFFu;
+  duco_life_encode(r, file);
+  r.seq = 0;
+  duco_life_encode(r, file + DUCO_LIFE_REC_SIZE);
+  slot = duco_life_pick(file, sizeof(file), got);
+  check("life", slot == 1 && got.seq == 0, "pick: seq wraps");
+
+  // 書くタイミング: シェアの増分 / 時間（何か増えていれば）
+  DucoLifeRecord w, n;
+  n = w;
+  n.accepted = 255;
+  check("life", !duco_life_flush_due(n, w, 1000, 600000, 256), "flush: below share delta");
+  n.rejected = 1;
+  check("life", duco_life_flush_due(n, w, 1000, 600000, 256), "flush: share delta");
+  n = w;
+  n.hashes = 1;
+  check("life", !duco_life_flush_due(n, w, 599999, 600000, 256), "flush: before interval");
+  check("life", duco_life_flush_due(n, w, 600000, 600000, 256), "flush: interval");
+  check("life", !duco_life_flush_due(w, w, 600000, 600000, 256), "flush: nothing changed");
+  check("life", !duco_life_flush_due(n, w, 600000, 0, 0), "flush: disabled");
+
+  return suiteDone("life", fail0);
+}
+
+// ---------- ジョブのトレース（duco_trace）：レコード / ヘッダ / hex の往復 ----------
+static bool runTrace() {
+  const int fail0 = g_fail;
+
+  const char* prev = "d6f4c64a3a4cd3e8b2e1e57a6e3f1d1b4e0cbd07";
+  DucoTraceRecord a;
+  check("trace", duco_trace_set_prev(a, prev, strlen(prev)), "prev: 40 hex");
+  check("trace", !duco_trace_set_prev(a, prev, 39), "prev: short rejected");
+  check("trace", !duco_trace_set_prev(a, "g6f4c64a3a4cd3e8b2e1e57a6e3f1d1b4e0cbd07", 40),
+        "prev: not hex rejected");
+  for (int i = 0; i < 20; ++i) a.expected[i] = (uint8_t)(0xA0 + i);
+  a.difficulty = 0x01020304u;
+  a.nonce      = 0xFFFFFFFFu;
+  a.hashes     = 3000000;
+  a.solve_us   = 0x89ABCDEFu;
+  a.feedback   = DUCO_TRACE_FB_LOST;
+  a.thread     = 5;
+  a.flags      = 0xBEEF;
+
+  uint8_t rec[DUCO_TRACE_REC_SIZE];
+  duco_trace_encode(a, rec);
+  check("trace", rec[40] == 0x04 && rec[43] == 0x01, "encode: little endian");
+  DucoTraceRecord b;
+  duco_trace_decode(rec, b);
+  char hex[41];
+  duco_trace_prev_hex(b, hex);
+  check("trace", strcmp(hex, prev) == 0 && memcmp(b.expected, a.expected, 20) == 0,
+        "round trip: prev / expected");
+  check("trace", b.difficulty == a.difficulty && b.nonce == a.nonce && b.hashes == a.hashes &&
+                 b.solve_us == a.solve_us && b.feedback == a.feedback && b.thread == a.thread &&
+                 b.flags == a.flags, "round trip: fields");
+
+  // シリアルの "@TRC <hex>" 行
+  char line[DUCO_TRACE_REC_SIZE * 2 + 1];
+  duco_trace_to_hex(rec, line);
+  uint8_t back[DUCO_TRACE_REC_SIZE];
+  check("trace", strlen(line) == DUCO_TRACE_REC_SIZE * 2 &&
+                 duco_trace_from_hex(line, strlen(line), back) &&
+                 memcmp(back, rec, sizeof(rec)) == 0, "hex: round trip");
+  check("trace", !duco_trace_from_hex(line, strlen(line) - 2, back), "hex: short rejected");
+  line[7] = 'x';
+  check("trace", !duco_trace_from_hex(line, strlen(line), back), "hex: bad digit rejected");
+
+  uint8_t hdr[DUCO_TRACE_HDR_SIZE];
+  duco_trace_write_header(hdr);
+  check("trace", duco_trace_check_header(hdr, sizeof(hdr)), "header: round trip");
+  check("trace", !duco_trace_check_header(hdr, sizeof(hdr) - 1), "header: short rejected");
+  hdr[0] ^= 0x20;
+  check("trace", !duco_trace_check_header(hdr, sizeof(hdr)), "header: magic");
+
+  return suiteDone("trace", fail0);
+}
+
+// ---------- 起動時と同じキャリブレーション（実機では mbedtls も候補に入る） ----------
+static uint64_t nowUs() {
+  return (uint64_t)(nowSec() * 1e6);
+}
+
+static void benchCalibrate(uint32_t n) {
+  DucoS1CalibResult res[DUCO_S1_MAX_KERNELS];
+  size_t count = 0;
+  const DucoS1Kernel* best = duco_s1_calibrate(n, nowUs, res, DUCO_S1_MAX_KERNELS, count);
+  for (size_t i = 0; i < count; ++i) {
+    printf("calib: %-21s %10.0f /s  (%s)\n",
+           res[i].kernel->name, res[i].hps, res[i].ok ? "ok" : "FAIL");
+  }
+  printf("calib: selected %s\n", best ? best->name : "(none)");
+}
+
+int main(int argc, char** argv) {
+  // "kat" だけ渡すと既知解テストのみ（CI / 手元の確認用）
+  if (argc > 1 && strcmp(argv[1], "kat") == 0) {
+    return runKat() ? 0 : 1;
+  }
+  if (argc > 1 && strcmp(argv[1], "proto") == 0) {
+    return runProto() ? 0 : 1;
+  }
+  if (argc > 1 && strcmp(argv[1], "pool") == 0) {
+    return runPool() ? 0 : 1;
+  }
+  if (argc > 1 && strcmp(argv[1], "hr") == 0) {
+    return runHr() ? 0 : 1;
+  }
+  if (argc > 1 && strcmp(argv[1], "lat") == 0) {
+    return runLat() ? 0 : 1;
+  }
+  if (argc > 1 && strcmp(argv[1], "life") == 0) {
+    return runLife() ? 0 : 1;
+  }
+  if (argc > 1 && strcmp(argv[1], "trace") == 0) {
+    return runTrace() ? 0 : 1;
+  }
+
+  uint32_t n = 2000000;
+  if (argc > 1) n = (uint32_t)strtoul(argv[1], nullptr, 10);
+
+  printf("[BENCH] DUCO-S1 n=%u\n", (unsigned)n);
+  if (!runKat()) return 1;
+  if (!runProto()) return 1;
+  if (!runPool()) return 1;
+  if (!runHr()) return 1;
+  if (!runLat()) return 1;
+  if (!runLife()) return 1;
+  if (!runTrace()) return 1;
+  benchFormat(n);
+  benchHash(n);
+  benchScan(n);
+  benchProto(n / 10);
+  benchCalibrate(n / 10);
+  return 0;
+}
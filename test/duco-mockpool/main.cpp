@@ -0,0 +1,310 @@
+// test/duco-mockpool/main.cpp
+// ===== プールの代わり + ジョブループの通し測定（ホスト） =====
+//   pio run -e duco-mockpool -t exec
+//
+// 既定: ループバックにプールの代わり（mock_pool）を立て、実機のプール I/O とワーカーのジョブループ
+// （src/duco_io.cpp。I/O スレッド1本が全接続を持ってジョブキューに積む → 計算だけのワーカー）を
+// secs 秒走らせて、shares/min・time-to-share・ワーカーの待ち時間の割合を出す。
+// duco_io・ソルバー（duco_s1 カーネル）・プロトコル（duco_proto）は実機と同じコード。
+// WiFiClient / FreeRTOS のキューと通知は shim/ の置き換え（POSIX ソケット / std::thread）で組む。
+//
+// 引数（key=value。省略時は既定値）:
+//   threads=2 spare=1 pipeline=0 poll_ms=5 secs=10 log=0    … マイナー側（config.h の MC_* と同じ意味。
+//                                                              log=1 で duco_io のログ [DUCO-C*] も出す）
+//   diff=30000 latency=30 reject=0 disconnect=0 seed=1       … プール側（mock_pool.h）
+//   serve port=2811 …  プールの代わりだけを 0.0.0.0 で立てる（実機から SET pool_nodes で繋ぐ）
+// 終了コード: 受理 0 件 / 間違った答えを submit した -> 1
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "duco_io.h"
+#include "duco_s1.h"
+#include "duco_s1_kernels.h"
+#include "mock_pool.h"
+
+static double nowSec() {
+  using namespace std::chrono;
+  return duration_cast<duration<double> >(
+           steady_clock::now().time_since_epoch()).count();
+}
+
+static uint64_t nowUs() {
+  return (uint64_t)(nowSec() * 1e6);
+}
+
+// ---------- 引数 ----------
+struct Args {
+  int      threads    = 2;
+  int      spare      = 1;
+  bool     pipeline   = false;
+  int      pollMs     = 5;
+  double   secs       = 10.0;
+  bool     log        = false;
+  bool     serve      = false;
+  MockPoolConfig pool;
+};
+
+static bool parseArgs(int argc, char** argv, Args& a) {
+  for (int i = 1; i < argc; ++i) {
+    const char* s = argv[i];
+    if (strcmp(s, "serve") == 0) {
+      a.serve        = true;
+      a.pool.anyAddr = true;
+      if (!a.pool.port) a.pool.port = 2811;
+      continue;
+    }
+    const char* eq = strchr(s, '=');
+    if (!eq) return false;
+    const size_t kl = (size_t)(eq - s);
+    const char*  v  = eq + 1;
+#define ARG_IS(k) (kl == strlen(k) && strncmp(s, k, kl) == 0)
+    if      (ARG_IS("threads"))    a.threads = atoi(v);
+    else if (ARG_IS("spare"))      a.spare = atoi(v);
+    else if (ARG_IS("pipeline"))   a.pipeline = atoi(v) != 0;
+    else if (ARG_IS("poll_ms"))    a.pollMs = atoi(v);
+    else if (ARG_IS("secs"))       a.secs = atof(v);
+    else if (ARG_IS("log"))        a.log = atoi(v) != 0;
+    else if (ARG_IS("diff"))       a.pool.difficulty = (uint32_t)strtoul(v, nullptr, 10);
+    else if (ARG_IS("latency"))    a.pool.latencyMs = (uint32_t)strtoul(v, nullptr, 10);
+    else if (ARG_IS("reject"))     a.pool.rejectRate = (float)atof(v);
+    else if (ARG_IS("disconnect")) a.pool.disconnectEvery = (uint32_t)strtoul(v, nullptr, 10);
+    else if (ARG_IS("seed"))       a.pool.seed = (uint32_t)strtoul(v, nullptr, 10);
+    else if (ARG_IS("port"))       a.pool.port = (uint16_t)atoi(v);
+    else return false;
+#undef ARG_IS
+  }
+  if (a.threads < 1) a.threads = 1;
+  if (a.spare < 0) a.spare = 0;
+  if (a.pollMs < 1) a.pollMs = 1;
+  return true;
+}
+
+// ---------- マイナー（src/duco_io.cpp をそのまま回す） ----------
+// 接続の状態遷移・JOB / submit / feedback・ジョブキュー・結果リング・停めたジョブの扱いは実機と同じコード。
+// mining_task が持つ側（DucoIoHooks）だけここで用意する：数えるだけのフックと、カーネルで解く solve。
+struct HostMiner {
+  const DucoS1Kernel* kernel = nullptr;
+  std::atomic<bool>   stop{false};
+
+  // フックから（I/O スレッドだけが書く）
+  uint32_t            accepted = 0, rejected = 0, lost = 0, notFound = 0;
+  std::vector<double> timeToShareMs;
+  std::vector<double> turnMs;
+  // ワーカーごと（各ワーカーだけが書く）
+  double   idleSec[DUCO_IO_MAX_WORKERS] = {0};
+  double   busySec[DUCO_IO_MAX_WORKERS] = {0};
+  uint64_t hashes[DUCO_IO_MAX_WORKERS]  = {0};
+};
+static HostMiner g_miner;
+
+static void hostIdent(DucoIoIdent& id) {
+  id.user    = "mock";
+  id.key     = "None";
+  id.banner  = "MockBench";
+  id.version = "0.0";
+  id.rig     = "host";
+  id.chip    = "000000000000";
+}
+
+static void hostShare(const DucoConn&, bool accepted) {
+  if (accepted) ++g_miner.accepted;
+  else          ++g_miner.rejected;
+}
+
+// 前の結果から次のジョブを積むまで（DucoConn::last_turn_ms）
+static void hostJobQueued(const DucoConn&, float turnMs) {
+  if (turnMs >= 0.0f) g_miner.turnMs.push_back(turnMs);
+}
+
+// time-to-share = JOB を送ってから GOOD / BLOCK まで（ping + キューに積んでから結果 + feedback）
+static void hostRecord(const MiningJobRecord& r) {
+  if (r.result == MINING_JOB_NONE) ++g_miner.notFound;
+  if (r.result == MINING_JOB_LOST && !g_miner.stop) ++g_miner.lost;   // 終わりに閉じた分は数えない
+  if (r.result == MINING_JOB_GOOD || r.result == MINING_JOB_BLOCK) {
+    g_miner.timeToShareMs.push_back(r.ping_ms + r.wall_us / 1000.0 + r.fb_ms);
+  }
+}
+
+struct PollCtx {
+  const uint32_t* gen;
+  uint32_t        want;
+};
+
+// 止めた / 接続が切れた（世代が変わった）ら打ち切る（実機の solver_poll_ と同じ見方）
+static bool pollCb(DucoS1Control& ctl, uint32_t) {
+  const PollCtx* p = (const PollCtx*)ctl.user;
+  return !g_miner.stop && __atomic_load_n(p->gen, __ATOMIC_RELAXED) == p->want;
+}
+
+static uint32_t hostSolve(int idx, const DucoJobMsg& job, const uint32_t* connGen,
+                          DucoIoSolve& out) {
+  DucoS1Job s1;
+  if (!duco_s1_prepare(s1, job.prev, job.prevLen)) return DUCO_S1_NOT_FOUND;
+  duco_s1_set_target(s1, job.expected);
+  PollCtx pc = {connGen, job.connGen};
+  DucoS1Control ctl;
+  ctl.every = 65536;
+  ctl.poll  = pollCb;
+  ctl.user  = &pc;
+  const double t0 = nowSec();
+  uint32_t h = 0;
+  const uint32_t nonce = g_miner.kernel->scan(s1, job.next, job.difficulty * 100u, h, ctl);
+  g_miner.busySec[idx] += nowSec() - t0;
+  g_miner.hashes[idx]  += h;
+  out.hashes = h;
+  out.own    = h;
+  out.next   = job.next + h;
+  return nonce;
+}
+
+// mining_task の duco_task と同じ：キューからジョブを取って duco_io_run_job
+static void workerLoop(int idx) {
+  while (!g_miner.stop) {
+    const double tw = nowSec();
+    DucoJobMsg job;
+    const bool got = duco_io_job_take(job, 100);
+    g_miner.idleSec[idx] += nowSec() - tw;
+    if (got) duco_io_run_job(idx, job);
+  }
+}
+
+// mining_task の duco_io_task と同じ：結果 → 全接続を 1 歩 → 結果が来るか poll_ms まで待つ
+static void ioLoop(int want, int pollMs) {
+  duco_io_set_task(xTaskGetCurrentTaskHandle());
+  while (!g_miner.stop) {
+    duco_io_results(want);
+    duco_io_step_all(want);
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(pollMs));
+  }
+  duco_io_close_all();
+}
+
+static double percentile(std::vector<double> v, double p) {
+  if (v.empty()) return 0.0;
+  std::sort(v.begin(), v.end());
+  size_t i = (size_t)(p * (double)(v.size() - 1) + 0.5);
+  if (i >= v.size()) i = v.size() - 1;
+  return v[i];
+}
+
+static volatile sig_atomic_t g_sigStop = 0;
+static void onSig(int) { g_sigStop = 1; }
+
+static int runServe(const Args& a) {
+  MockPool pool;
+  if (!pool.start(a.pool)) {
+    printf("[MOCK] cannot listen on port %u\n", (unsigned)a.pool.port);
+    return 1;
+  }
+  printf("[MOCK] serving on 0.0.0.0:%u diff=%u latency=%ums reject=%.2f disconnect=%u (Ctrl-C to stop)\n",
+         (unsigned)pool.port(), (unsigned)a.pool.difficulty, (unsigned)a.pool.latencyMs,
+         a.pool.rejectRate, (unsigned)a.pool.disconnectEvery);
+  signal(SIGINT, onSig);
+  double next = nowSec() + 10.0;
+  while (!g_sigStop) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (nowSec() < next) continue;
+    next += 10.0;
+    const MockPoolStats s = pool.stats();
+    printf("[MOCK] conns=%u jobs=%u submits=%u good=%u bad=%u bad_nonce=%u disconnects=%u\n",
+           (unsigned)s.connections, (unsigned)s.jobs, (unsigned)s.submits, (unsigned)s.good,
+           (unsigned)s.bad, (unsigned)s.badNonce, (unsigned)s.disconnects);
+  }
+  pool.stop();
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  Args a;
+  if (!parseArgs(argc, argv, a)) {
+    printf("usage: %s [serve] [threads=N] [spare=N] [pipeline=0|1] [poll_ms=N] [secs=S] [log=0|1]\n"
+           "       [diff=N] [latency=MS] [reject=0..1] [disconnect=N] [seed=N] [port=N]\n", argv[0]);
+    return 2;
+  }
+  if (a.serve) return runServe(a);
+
+  if (a.threads > DUCO_IO_MAX_WORKERS || a.threads + a.spare > DUCO_IO_MAX_CONNS) {
+    printf("threads must be <= %d and threads + spare <= %d (MC_MINER_MAX_THREADS)\n",
+           (int)DUCO_IO_MAX_WORKERS, (int)DUCO_IO_MAX_CONNS);
+    return 2;
+  }
+
+  // 実機の startMiner と同じく、測って一番速いカーネルを使う
+  DucoS1CalibResult res[DUCO_S1_MAX_KERNELS];
+  size_t nres = 0;
+  const DucoS1Kernel* kernel = duco_s1_calibrate(200000, nowUs, res, DUCO_S1_MAX_KERNELS, nres);
+  if (!kernel) {
+    printf("[MINER] no working kernel\n");
+    return 1;
+  }
+
+  MockPool pool;
+  if (!pool.start(a.pool)) {
+    printf("[MOCK] cannot listen\n");
+    return 1;
+  }
+  printf("[MOCK] 127.0.0.1:%u diff=%u latency=%ums reject=%.2f disconnect=%u\n",
+         (unsigned)pool.port(), (unsigned)a.pool.difficulty, (unsigned)a.pool.latencyMs,
+         a.pool.rejectRate, (unsigned)a.pool.disconnectEvery);
+  printf("[MINER] kernel=%s threads=%d spare=%d pipeline=%d poll_ms=%d secs=%.1f\n",
+         kernel->name, a.threads, a.spare, a.pipeline ? 1 : 0, a.pollMs, a.secs);
+
+  if (a.log) Serial.begin(115200);
+  g_miner.kernel = kernel;
+  DucoIoHooks hooks;
+  hooks.ident      = hostIdent;
+  hooks.share      = hostShare;
+  hooks.job_queued = hostJobQueued;
+  hooks.record     = hostRecord;
+  hooks.solve      = hostSolve;
+  duco_io_begin(hooks, a.threads);
+  duco_io_set_pool("127.0.0.1", pool.port(), "mock");
+  duco_io_set_pipelined(a.pipeline);
+
+  const double t0 = nowSec();
+  std::thread io(ioLoop, a.threads + a.spare, a.pollMs);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < a.threads; ++i) workers.push_back(std::thread(workerLoop, i));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds((long)(a.secs * 1000.0)));
+  g_miner.stop = true;
+  for (size_t i = 0; i < workers.size(); ++i) workers[i].join();
+  const double wall = nowSec() - t0;
+  io.join();
+  pool.stop();
+
+  const HostMiner& m = g_miner;
+  double   idle = 0.0, busy = 0.0;
+  uint64_t h    = 0;
+  for (int i = 0; i < a.threads; ++i) {
+    idle += m.idleSec[i];
+    busy += m.busySec[i];
+    h    += m.hashes[i];
+  }
+  const MockPoolStats ps = pool.stats();
+
+  printf("result: shares/min=%.1f accepted=%u rejected=%u (lost=%u) not_found=%u\n",
+         m.accepted * 60.0 / wall, (unsigned)m.accepted, (unsigned)m.rejected,
+         (unsigned)m.lost, (unsigned)m.notFound);
+  printf("result: time_to_share ms p50=%.1f p95=%.1f max=%.1f  turn ms p50=%.1f p95=%.1f\n",
+         percentile(m.timeToShareMs, 0.50), percentile(m.timeToShareMs, 0.95),
+         percentile(m.timeToShareMs, 1.0),
+         percentile(m.turnMs, 0.50), percentile(m.turnMs, 0.95));
+  printf("result: idle=%.1f%% busy=%.1f%% hashrate=%.0f kH/s (compute %.0f kH/s)\n",
+         100.0 * idle / (wall * a.threads), 100.0 * busy / (wall * a.threads),
+         h / wall / 1000.0, busy > 0 ? h / (busy / a.threads) / 1000.0 : 0.0);
+  printf("pool:   conns=%u jobs=%u submits=%u good=%u bad=%u bad_nonce=%u disconnects=%u\n",
+         (unsigned)ps.connections, (unsigned)ps.jobs, (unsigned)ps.submits, (unsigned)ps.good,
+         (unsigned)ps.bad, (unsigned)ps.badNonce, (unsigned)ps.disconnects);
+
+  return (m.accepted > 0 && ps.badNonce == 0) ? 0 : 1;
+}
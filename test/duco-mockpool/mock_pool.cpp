@@ -0,0 +1,209 @@
+// test/duco-mockpool/mock_pool.cpp
+#include "mock_pool.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+
+#include "duco_proto.h"
+#include "duco_s1.h"
+
+namespace {
+
+struct Rng {
+  uint32_t s;
+  explicit Rng(uint32_t seed) : s(seed ? seed : 0x9E3779B9u) {}
+  uint32_t next() {
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+  }
+  float unit() { return (float)(next() >> 8) / (float)(1u << 24); }
+};
+
+void sleepMs(uint32_t ms) {
+  if (ms) std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+bool sendAll(int fd, const char* p, size_t n) {
+  while (n) {
+    const ssize_t w = send(fd, p, n, MSG_NOSIGNAL);
+    if (w <= 0) return false;
+    p += w;
+    n -= (size_t)w;
+  }
+  return true;
+}
+
+void sha1Hex(const char* prev, uint32_t nonce, uint8_t out[20]) {
+  DucoS1Job job;
+  duco_s1_prepare(job, prev, DUCO_S1_SEED_LEN);
+  char d[10];
+  const int n = duco_s1_u32_to_dec(d, nonce);
+  duco_s1_hash(job, d, (size_t)n, out);
+}
+
+const char kHex[] = "0123456789abcdef";
+
+}  // namespace
+
+bool MockPool::start(const MockPoolConfig& cfg) {
+  cfg_ = cfg;
+  if (cfg_.difficulty == 0) cfg_.difficulty = 1;
+  stop_ = false;
+
+  listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+  if (listenFd_ < 0) return false;
+  const int one = 1;
+  setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  sockaddr_in a;
+  memset(&a, 0, sizeof(a));
+  a.sin_family      = AF_INET;
+  a.sin_addr.s_addr = htonl(cfg_.anyAddr ? INADDR_ANY : INADDR_LOOPBACK);
+  a.sin_port        = htons(cfg_.port);
+  socklen_t len = sizeof(a);
+  if (bind(listenFd_, (sockaddr*)&a, sizeof(a)) != 0 || listen(listenFd_, 16) != 0 ||
+      getsockname(listenFd_, (sockaddr*)&a, &len) != 0) {
+    close(listenFd_);
+    listenFd_ = -1;
+    return false;
+  }
+  port_     = ntohs(a.sin_port);
+  acceptTh_ = std::thread(&MockPool::acceptLoop_, this);
+  return true;
+}
+
+void MockPool::stop() {
+  if (listenFd_ < 0) return;
+  stop_ = true;
+  if (acceptTh_.joinable()) acceptTh_.join();
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    for (size_t i = 0; i < clients_.size(); ++i) {
+      if (clients_[i].joinable()) clients_[i].join();
+    }
+    clients_.clear();
+  }
+  close(listenFd_);
+  listenFd_ = -1;
+}
+
+MockPoolStats MockPool::stats() const {
+  MockPoolStats s;
+  s.connections = connections_;
+  s.jobs        = jobs_;
+  s.submits     = submits_;
+  s.good        = good_;
+  s.bad         = bad_;
+  s.badNonce    = badNonce_;
+  s.disconnects = disconnects_;
+  return s;
+}
+
+void MockPool::acceptLoop_() {
+  uint32_t n = 0;
+  while (!stop_) {
+    pollfd pf = {listenFd_, POLLIN, 0};
+    if (poll(&pf, 1, 50) <= 0) continue;
+    const int fd = accept(listenFd_, nullptr, nullptr);
+    if (fd < 0) continue;
+    const int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    ++connections_;
+    const uint32_t seed = cfg_.seed * 2654435761u + (++n);
+    std::lock_guard<std::mutex> lk(mu_);
+    clients_.push_back(std::thread(&MockPool::serve_, this, fd, seed));
+  }
+}
+
+void MockPool::serve_(int fd, uint32_t seed) {
+  Rng      rng(seed);
+  char     prev[DUCO_S1_SEED_LEN + 1] = {0};
+  uint8_t  expected[20];
+  bool     haveJob = false;
+  uint32_t submits = 0;
+
+  sleepMs(cfg_.latencyMs);
+  if (!sendAll(fd, "3.0\n", 4)) {
+    close(fd);
+    return;
+  }
+
+  DucoLineBuf lb;
+  while (!stop_) {
+    pollfd pf = {fd, POLLIN, 0};
+    if (poll(&pf, 1, 50) <= 0) continue;
+    char buf[256];
+    const ssize_t r = recv(fd, buf, sizeof(buf), 0);
+    if (r <= 0) break;
+
+    for (ssize_t i = 0; i < r; ++i) {
+      if (!duco_line_push(lb, buf[i])) continue;
+
+      if (strncmp(lb.buf, "JOB,", 4) == 0) {
+        // 答えを先に決めて expected を作る
+        for (size_t k = 0; k < DUCO_S1_SEED_LEN; ++k) prev[k] = kHex[rng.next() & 15];
+        const uint32_t nonce = rng.next() % (cfg_.difficulty * 100u + 1u);
+        sha1Hex(prev, nonce, expected);
+        haveJob = true;
+
+        char line[DUCO_PROTO_LINE_MAX];
+        size_t o = 0;
+        memcpy(line, prev, DUCO_S1_SEED_LEN);
+        o += DUCO_S1_SEED_LEN;
+        line[o++] = ',';
+        for (int k = 0; k < 20; ++k) {
+          line[o++] = kHex[expected[k] >> 4];
+          line[o++] = kHex[expected[k] & 15];
+        }
+        line[o++] = ',';
+        o += duco_fmt_u32(line + o, cfg_.difficulty);
+        line[o++] = '\n';
+        ++jobs_;
+        sleepMs(cfg_.latencyMs);
+        if (!sendAll(fd, line, o)) goto done;
+        continue;
+      }
+
+      // submit: "<nonce>,<hashrate>,..."
+      ++submits_;
+      ++submits;
+      if (cfg_.disconnectEvery && submits % cfg_.disconnectEvery == 0) {
+        ++disconnects_;
+        goto done;
+      }
+      {
+        uint32_t nonce = 0;
+        const char* p = lb.buf;
+        while (*p >= '0' && *p <= '9') nonce = nonce * 10 + (uint32_t)(*p++ - '0');
+
+        const char* fb = "GOOD\n";
+        uint8_t got[20];
+        if (haveJob) sha1Hex(prev, nonce, got);
+        if (!haveJob || p == lb.buf || memcmp(got, expected, 20) != 0) {
+          ++badNonce_;
+          ++bad_;
+          fb = "BAD,Incorrect result\n";
+        } else if (rng.unit() < cfg_.rejectRate) {
+          ++bad_;
+          fb = "BAD,Rejected\n";
+        } else {
+          ++good_;
+        }
+        haveJob = false;
+        sleepMs(cfg_.latencyMs);
+        if (!sendAll(fd, fb, strlen(fb))) goto done;
+      }
+    }
+  }
+done:
+  close(fd);
+}
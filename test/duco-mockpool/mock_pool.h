@@ -0,0 +1,61 @@
+// test/duco-mockpool/mock_pool.h
+#pragma once
+// ホスト用のプールの代わり（小さな TCP サーバー）
+//
+//   banner "3.0" → JOB → "<prev>,<expected>,<diff>" → submit → GOOD / BAD
+//
+// ジョブは答えの nonce を先に決めてから expected を作るので、submit が正しいか確かめられる。
+// 返事の遅れ・reject 率・途中で切る頻度を変えられる。接続ごとに1スレッド（数本しか繋がない前提）。
+// 実機からも繋げる（anyAddr = true で 0.0.0.0 に。SET pool_nodes <PC の IP>:<port>）
+
+#include <stdint.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct MockPoolConfig {
+  uint32_t difficulty      = 30000;   // 答えは [0, difficulty*100] から一様に選ぶ
+  uint32_t latencyMs       = 30;      // banner / job / feedback を返すまで待つ
+  float    rejectRate      = 0.0f;    // 正しい答えでもこの割合で BAD を返す
+  uint32_t disconnectEvery = 0;       // 1 接続でこの数の submit を受けたら feedback を返さずに切る（0 = 切らない）
+  uint32_t seed            = 1;
+  bool     anyAddr         = false;   // false = 127.0.0.1 だけ
+  uint16_t port            = 0;       // 0 = 空いているポート
+};
+
+struct MockPoolStats {
+  uint32_t connections = 0;
+  uint32_t jobs        = 0;
+  uint32_t submits     = 0;
+  uint32_t good        = 0;
+  uint32_t bad         = 0;   // rejectRate で返した分も含む
+  uint32_t badNonce    = 0;   // 答えが違った（マイナー側のバグ）
+  uint32_t disconnects = 0;   // disconnectEvery で切った数
+};
+
+class MockPool {
+ public:
+  ~MockPool() { stop(); }
+
+  bool     start(const MockPoolConfig& cfg);
+  void     stop();
+  uint16_t port() const { return port_; }
+  MockPoolStats stats() const;
+
+ private:
+  void acceptLoop_();
+  void serve_(int fd, uint32_t seed);
+
+  MockPoolConfig           cfg_;
+  int                      listenFd_ = -1;
+  uint16_t                 port_     = 0;
+  std::atomic<bool>        stop_{false};
+  std::thread              acceptTh_;
+  std::mutex               mu_;        // clients_
+  std::vector<std::thread> clients_;
+
+  std::atomic<uint32_t> connections_{0}, jobs_{0}, submits_{0}, good_{0}, bad_{0},
+                        badNonce_{0}, disconnects_{0};
+};
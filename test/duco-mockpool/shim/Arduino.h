@@ -0,0 +1,45 @@
+// test/duco-mockpool/shim/Arduino.h
+#pragma once
+// ===== ホストで src/duco_io.cpp を組むための Arduino の置き換え（duco-mockpool 専用） =====
+// duco_io と、それが読むヘッダ（config.h / mc_config_store.h / mining_task.h / logging.h）が
+// 使う分だけ。時刻は steady_clock、Serial は begin() するまで何も出さない
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+unsigned long millis();
+unsigned long micros();
+void          delay(unsigned long ms);
+
+// 宣言に出てくるだけ（mc_config_store.h / mining_task.h の構造体）
+class String {
+ public:
+  String() {}
+  String(const char* s) : s_(s ? s : "") {}
+  const char*  c_str() const { return s_.c_str(); }
+  unsigned int length() const { return (unsigned int)s_.size(); }
+
+ private:
+  std::string s_;
+};
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(const uint8_t* p, size_t n) = 0;
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+  size_t println(const char* s);
+};
+
+class HostSerial : public Print {
+ public:
+  void   begin(unsigned long baud) { (void)baud; on_ = true; }
+  size_t write(const uint8_t* p, size_t n) override;
+
+ private:
+  bool on_ = false;
+};
+extern HostSerial Serial;
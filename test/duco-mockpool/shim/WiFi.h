@@ -0,0 +1,37 @@
+// test/duco-mockpool/shim/WiFi.h
+#pragma once
+// ===== WiFiClient / IPAddress / WiFi.hostByName の置き換え（POSIX ソケット） =====
+// duco_io が使う分だけ。WiFiClient(fd) は fd を預かり、stop() で閉じる（コピーしても閉じない）
+#include <stdint.h>
+#include <stddef.h>
+
+class IPAddress {
+ public:
+  bool fromString(const char* s);
+  operator uint32_t() const { return addr_; }   // ネットワークバイト順（ESP32 と同じ）
+  void set(uint32_t a) { addr_ = a; }
+
+ private:
+  uint32_t addr_ = 0;
+};
+
+class WiFiClient {
+ public:
+  WiFiClient() {}
+  explicit WiFiClient(int fd) : fd_(fd) {}
+  uint8_t connected();   // 相手が閉じていなければ 1（読んでいないデータがあっても 1）
+  int     available();
+  int     read();
+  size_t  write(const uint8_t* p, size_t n);
+  void    stop();
+  void    setTimeout(uint32_t s) { (void)s; }
+
+ private:
+  int fd_ = -1;
+};
+
+class HostWiFi {
+ public:
+  bool hostByName(const char* host, IPAddress& out);
+};
+extern HostWiFi WiFi;
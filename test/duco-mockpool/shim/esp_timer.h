@@ -0,0 +1,5 @@
+// test/duco-mockpool/shim/esp_timer.h
+#pragma once
+#include <stdint.h>
+
+int64_t esp_timer_get_time();   // [us]（起動からではなく steady_clock の起点から）
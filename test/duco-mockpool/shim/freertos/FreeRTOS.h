@@ -0,0 +1,15 @@
+// test/duco-mockpool/shim/freertos/FreeRTOS.h
+#pragma once
+// ===== FreeRTOS の置き換え（duco_io が使うキューとタスク通知だけ。1 tick = 1 ms） =====
+#include <stdint.h>
+
+typedef int32_t  BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE  ((BaseType_t)1)
+#define pdFALSE ((BaseType_t)0)
+#define pdPASS  pdTRUE
+#define pdFAIL  pdFALSE
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFu)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
@@ -0,0 +1,10 @@
+// test/duco-mockpool/shim/freertos/queue.h
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+typedef struct HostQueue* QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+BaseType_t    xQueueSend(QueueHandle_t q, const void* item, TickType_t wait);
+BaseType_t    xQueueSendToFront(QueueHandle_t q, const void* item, TickType_t wait);
+BaseType_t    xQueueReceive(QueueHandle_t q, void* item, TickType_t wait);
@@ -0,0 +1,11 @@
+// test/duco-mockpool/shim/freertos/task.h
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+// タスク = スレッド。ハンドルは初めて xTaskGetCurrentTaskHandle を呼んだときにできる
+typedef struct HostTask* TaskHandle_t;
+
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t   xTaskNotifyGive(TaskHandle_t t);
+uint32_t     ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t wait);
+void         vTaskDelay(TickType_t ticks);
@@ -0,0 +1,208 @@
+// test/duco-mockpool/shim/host_shim.cpp
+// ===== Arduino / WiFiClient / FreeRTOS の置き換えの中身（duco-mockpool 専用） =====
+#include <Arduino.h>
+#include <WiFi.h>
+#include <esp_timer.h>
+#include <lwip/sockets.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#include <errno.h>
+#include <netdb.h>
+#include <stdarg.h>
+#include <sys/ioctl.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ---------- 時刻 ----------
+static int64_t hostNowUs() {
+  using namespace std::chrono;
+  static const steady_clock::time_point t0 = steady_clock::now();
+  return duration_cast<microseconds>(steady_clock::now() - t0).count();
+}
+
+unsigned long millis() { return (unsigned long)(hostNowUs() / 1000); }
+unsigned long micros() { return (unsigned long)hostNowUs(); }
+void delay(unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+int64_t esp_timer_get_time() { return hostNowUs(); }
+
+// ---------- Serial ----------
+HostSerial Serial;
+
+size_t Print::printf(const char* fmt, ...) {
+  char buf[512];
+  va_list ap;
+  va_start(ap, fmt);
+  const int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+  if (n <= 0) return 0;
+  return write((const uint8_t*)buf, (size_t)n < sizeof(buf) ? (size_t)n : sizeof(buf) - 1);
+}
+
+size_t Print::println(const char* s) {
+  const size_t n = write((const uint8_t*)s, strlen(s));
+  return n + write((const uint8_t*)"\n", 1);
+}
+
+size_t HostSerial::write(const uint8_t* p, size_t n) {
+  if (!on_) return n;
+  return fwrite(p, 1, n, stdout);
+}
+
+// ---------- WiFiClient ----------
+bool IPAddress::fromString(const char* s) {
+  in_addr a;
+  if (!s || inet_pton(AF_INET, s, &a) != 1) return false;
+  addr_ = a.s_addr;
+  return true;
+}
+
+uint8_t WiFiClient::connected() {
+  if (fd_ < 0) return 0;
+  char ch;
+  const ssize_t r = recv(fd_, &ch, 1, MSG_PEEK | MSG_DONTWAIT);
+  if (r > 0) return 1;
+  if (r == 0) return 0;
+  return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 1 : 0;
+}
+
+int WiFiClient::available() {
+  if (fd_ < 0) return 0;
+  int n = 0;
+  if (ioctl(fd_, FIONREAD, &n) != 0) return 0;
+  return n;
+}
+
+int WiFiClient::read() {
+  if (fd_ < 0) return -1;
+  unsigned char ch;
+  return recv(fd_, &ch, 1, MSG_DONTWAIT) == 1 ? ch : -1;
+}
+
+size_t WiFiClient::write(const uint8_t* p, size_t n) {
+  size_t done = 0;
+  while (fd_ >= 0 && done < n) {
+    const ssize_t w = send(fd_, p + done, n - done, MSG_NOSIGNAL);
+    if (w <= 0) break;
+    done += (size_t)w;
+  }
+  return done;
+}
+
+void WiFiClient::stop() {
+  if (fd_ >= 0) close(fd_);
+  fd_ = -1;
+}
+
+HostWiFi WiFi;
+
+bool HostWiFi::hostByName(const char* host, IPAddress& out) {
+  addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  addrinfo* res = nullptr;
+  if (getaddrinfo(host, nullptr, &hints, &res) != 0 || !res) return false;
+  out.set(((sockaddr_in*)res->ai_addr)->sin_addr.s_addr);
+  freeaddrinfo(res);
+  return true;
+}
+
+// ---------- FreeRTOS: タスク通知 ----------
+struct HostTask {
+  std::mutex              mu;
+  std::condition_variable cv;
+  uint32_t                count = 0;
+};
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  static thread_local HostTask* self = nullptr;
+  if (!self) self = new HostTask;   // スレッドが終わっても通知してくる側がいるので解放しない
+  return self;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t t) {
+  {
+    std::lock_guard<std::mutex> lk(t->mu);
+    ++t->count;
+  }
+  t->cv.notify_one();
+  return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t wait) {
+  HostTask* t = xTaskGetCurrentTaskHandle();
+  std::unique_lock<std::mutex> lk(t->mu);
+  if (wait == portMAX_DELAY) {
+    t->cv.wait(lk, [t] { return t->count != 0; });
+  } else {
+    t->cv.wait_for(lk, std::chrono::milliseconds(wait), [t] { return t->count != 0; });
+  }
+  const uint32_t n = t->count;
+  if (n) t->count = clearOnExit ? 0 : n - 1;
+  return n;
+}
+
+void vTaskDelay(TickType_t ticks) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+// ---------- FreeRTOS: キュー ----------
+struct HostQueue {
+  std::mutex                        mu;
+  std::condition_variable           cv;
+  std::deque<std::vector<uint8_t> > items;
+  size_t                            length   = 0;
+  size_t                            itemSize = 0;
+};
+
+// wait の間に pred が真になれば true（lk は握ったまま返す）
+template <typename Pred>
+static bool queueWait(HostQueue* q, std::unique_lock<std::mutex>& lk, TickType_t wait, Pred pred) {
+  if (wait == portMAX_DELAY) {
+    q->cv.wait(lk, pred);
+    return true;
+  }
+  return q->cv.wait_for(lk, std::chrono::milliseconds(wait), pred);
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+  HostQueue* q = new HostQueue;
+  q->length    = length;
+  q->itemSize  = itemSize;
+  return q;
+}
+
+static BaseType_t queuePut(QueueHandle_t q, const void* item, TickType_t wait, bool front) {
+  std::unique_lock<std::mutex> lk(q->mu);
+  if (!queueWait(q, lk, wait, [q] { return q->items.size() < q->length; })) return pdFALSE;
+  const uint8_t* p = (const uint8_t*)item;
+  if (front) q->items.push_front(std::vector<uint8_t>(p, p + q->itemSize));
+  else       q->items.push_back(std::vector<uint8_t>(p, p + q->itemSize));
+  lk.unlock();
+  q->cv.notify_all();
+  return pdTRUE;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t wait) {
+  return queuePut(q, item, wait, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t q, const void* item, TickType_t wait) {
+  return queuePut(q, item, wait, true);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t wait) {
+  std::unique_lock<std::mutex> lk(q->mu);
+  if (!queueWait(q, lk, wait, [q] { return !q->items.empty(); })) return pdFALSE;
+  memcpy(item, q->items.front().data(), q->itemSize);
+  q->items.pop_front();
+  lk.unlock();
+  q->cv.notify_all();
+  return pdTRUE;
+}
@@ -0,0 +1,9 @@
+// test/duco-mockpool/shim/lwip/sockets.h
+#pragma once
+// lwIP のソケット API は POSIX と同じ名前なので、ホストではそのまま
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
@@ -0,0 +1,361 @@
+// test/duco-replay/main.cpp
+// ===== 実機のジョブトレースをホストで解き直す =====
+//   pio run -e duco-replay && .pio/build/duco-replay/program <trace> [kernel=all] [repeat=1]
+//
+// <trace> は次のどちらでもいい（duco_trace.h）:
+//   - LittleFS の /duco_trace.bin をそのまま取り出したもの（ヘッダ + 固定長レコード）
+//   - シリアルのログ（TRACE SERIAL / TRACE DUMP の "@TRC <hex>" 行。他の行は読み飛ばす）
+// 各カーネルで全レコードを [0, difficulty*100] で解き直し、jobs/s・MH/s と
+// 記録した nonce との食い違い（NONE は「見つからない」が正解）を出す。
+// 実機の数字（hashes / solve_us）も並べるので、カーネルを変えたときの差をジョブ列ごと比べられる。
+//
+//   synth <out.bin> [n=200] [seed=1] [diffs=750,1500,3000,6000]
+//     … 答えの分かっている合成トレースを作る（実機なしで試す用。1 割は NONE）
+//   kat <trace> [max=8]
+//     … プールが GOOD / BLOCK を返したジョブを、参照カーネルで確かめてから
+//       duco_s1_kat.cpp の kVectors に貼れる行で出す（合成トレースのレコードは出さない）
+// 終了コード: 食い違いあり / 読めない -> 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "duco_s1.h"
+#include "duco_s1_kernels.h"
+#include "duco_trace.h"
+
+static double nowSec() {
+  using namespace std::chrono;
+  return duration_cast<duration<double> >(
+           steady_clock::now().time_since_epoch()).count();
+}
+
+static const char* kFeedbackName[] = {"good", "block", "bad", "none", "lost"};
+
+// ---------- 読み込み ----------
+static bool readFile(const char* path, std::vector<uint8_t>& out) {
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+  fclose(f);
+  return true;
+}
+
+// バイナリ（ヘッダ付き）か "@TRC <hex>" 行のログか
+static bool loadTrace(const char* path, std::vector<DucoTraceRecord>& recs, size_t& skipped) {
+  std::vector<uint8_t> data;
+  if (!readFile(path, data)) {
+    fprintf(stderr, "cannot read %s\n", path);
+    return false;
+  }
+  skipped = 0;
+  uint8_t rec[DUCO_TRACE_REC_SIZE];
+  DucoTraceRecord r;
+
+  if (duco_trace_check_header(data.data(), data.size())) {
+    size_t off = DUCO_TRACE_HDR_SIZE;
+    for (; off + DUCO_TRACE_REC_SIZE <= data.size(); off += DUCO_TRACE_REC_SIZE) {
+      duco_trace_decode(&data[off], r);
+      recs.push_back(r);
+    }
+    if (off != data.size()) ++skipped;   // 書きかけの最後の 1 件
+    return true;
+  }
+
+  size_t i = 0;
+  while (i < data.size()) {
+    size_t e = i;
+    while (e < data.size() && data[e] != '\n') ++e;
+    const char* line = (const char*)&data[i];
+    size_t len = e - i;
+    while (len && (line[len - 1] == '\r' || line[len - 1] == ' ')) --len;
+    const char* p = (const char*)memmem(line, len, "@TRC ", 5);
+    if (p) {
+      const size_t hexLen = len - (size_t)(p + 5 - line);
+      if (duco_trace_from_hex(p + 5, hexLen, rec)) {
+        duco_trace_decode(rec, r);
+        recs.push_back(r);
+      } else {
+        ++skipped;
+      }
+    }
+    i = e + 1;
+  }
+  if (recs.empty()) {
+    fprintf(stderr, "%s: no trace header and no @TRC lines\n", path);
+    return false;
+  }
+  return true;
+}
+
+// ---------- 合成トレース ----------
+static uint32_t xorshift(uint32_t& s) {
+  s ^= s << 13;
+  s ^= s >> 17;
+  s ^= s << 5;
+  return s;
+}
+
+static int runSynth(int argc, char** argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s synth <out.bin> [n=200] [seed=1] [diffs=750,1500,3000,6000]\n",
+            argv[0]);
+    return 1;
+  }
+  const char* out = argv[2];
+  uint32_t n = 200, seed = 1;
+  std::vector<uint32_t> diffs;
+  for (int i = 3; i < argc; ++i) {
+    if (strncmp(argv[i], "n=", 2) == 0) n = (uint32_t)strtoul(argv[i] + 2, nullptr, 10);
+    else if (strncmp(argv[i], "seed=", 5) == 0) seed = (uint32_t)strtoul(argv[i] + 5, nullptr, 10);
+    else if (strncmp(argv[i], "diffs=", 6) == 0) {
+      const char* p = argv[i] + 6;
+      while (*p) {
+        char* e;
+        const unsigned long d = strtoul(p, &e, 10);
+        if (e == p) break;
+        if (d) diffs.push_back((uint32_t)d);
+        p = (*e == ',') ? e + 1 : e;
+      }
+    } else {
+      fprintf(stderr, "unknown arg: %s\n", argv[i]);
+      return 1;
+    }
+  }
+  if (diffs.empty()) diffs = {750, 1500, 3000, 6000};
+  if (!seed) seed = 1;
+
+  FILE* f = fopen(out, "wb");
+  if (!f) {
+    fprintf(stderr, "cannot write %s\n", out);
+    return 1;
+  }
+  uint8_t hdr[DUCO_TRACE_HDR_SIZE];
+  duco_trace_write_header(hdr);
+  fwrite(hdr, 1, sizeof(hdr), f);
+
+  static const char kHex[] = "0123456789abcdef";
+  for (uint32_t i = 0; i < n; ++i) {
+    DucoTraceRecord r;
+    char prev[DUCO_S1_SEED_LEN];
+    for (size_t k = 0; k < DUCO_S1_SEED_LEN; ++k) prev[k] = kHex[xorshift(seed) & 15];
+    duco_trace_set_prev(r, prev, sizeof(prev));
+    r.difficulty = diffs[xorshift(seed) % diffs.size()];
+    r.thread     = (uint8_t)(i & 1);
+
+    // 1 割は範囲の外に答えを置く（= NONE）
+    const uint32_t range = r.difficulty * 100u;
+    const bool none = (xorshift(seed) % 10) == 0;
+    const uint32_t nonce = none ? range + 1 + xorshift(seed) % 1000 : xorshift(seed) % (range + 1);
+
+    DucoS1Job job;
+    duco_s1_prepare(job, prev, sizeof(prev));
+    char d[10];
+    const int dn = duco_s1_u32_to_dec(d, nonce);
+    duco_s1_hash(job, d, (size_t)dn, r.expected);
+
+    r.nonce    = none ? 0xFFFFFFFFu : nonce;
+    r.hashes   = none ? range + 1 : nonce + 1;
+    r.solve_us = r.hashes * 20;   // 実機（約 50 kH/s / スレッド）のつもりの値
+    r.feedback = none ? DUCO_TRACE_FB_NONE : DUCO_TRACE_FB_GOOD;
+    r.flags    = DUCO_TRACE_FLAG_SYNTH;
+
+    uint8_t rec[DUCO_TRACE_REC_SIZE];
+    duco_trace_encode(r, rec);
+    fwrite(rec, 1, sizeof(rec), f);
+  }
+  fclose(f);
+  printf("wrote %u records to %s\n", (unsigned)n, out);
+  return 0;
+}
+
+// ---------- 既知解テストのベクタに ----------
+// 実機のトレースから、プールが受け付けたジョブだけを拾う。難易度ごとに 1 件まで、
+// 参照カーネル（duco_s1_scan）で記録した nonce が当たることを確かめたものだけ出す
+static int runKat(int argc, char** argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s kat <trace> [max=8]\n", argv[0]);
+    return 1;
+  }
+  uint32_t max = 8;
+  for (int i = 3; i < argc; ++i) {
+    if (strncmp(argv[i], "max=", 4) == 0) max = (uint32_t)strtoul(argv[i] + 4, nullptr, 10);
+    else {
+      fprintf(stderr, "unknown arg: %s\n", argv[i]);
+      return 1;
+    }
+  }
+
+  std::vector<DucoTraceRecord> recs;
+  size_t skipped = 0;
+  if (!loadTrace(argv[2], recs, skipped)) return 1;
+
+  static const char kHex[] = "0123456789abcdef";
+  std::vector<uint32_t> seen;
+  uint32_t out = 0, synth = 0, wrong = 0;
+  DucoS1Control ctl;
+  for (size_t i = 0; i < recs.size() && out < max; ++i) {
+    const DucoTraceRecord& r = recs[i];
+    if (r.flags & DUCO_TRACE_FLAG_SYNTH) {
+      ++synth;
+      continue;
+    }
+    if (r.feedback != DUCO_TRACE_FB_GOOD && r.feedback != DUCO_TRACE_FB_BLOCK) continue;
+    if (r.nonce > r.difficulty * 100u) continue;
+    size_t k = 0;
+    while (k < seen.size() && seen[k] != r.difficulty) ++k;
+    if (k < seen.size()) continue;
+
+    char prev[41];
+    duco_trace_prev_hex(r, prev);
+    DucoS1Job job;
+    duco_s1_prepare(job, prev, DUCO_S1_SEED_LEN);
+    duco_s1_set_target(job, r.expected);
+    uint32_t hashes = 0;
+    const uint32_t lo = (r.nonce > 64) ? r.nonce - 64 : 0;
+    if (duco_s1_scan(job, lo, r.nonce, hashes, ctl) != r.nonce) {
+      ++wrong;
+      continue;
+    }
+
+    char expected[41];
+    for (int b = 0; b < 20; ++b) {
+      expected[b * 2]     = kHex[r.expected[b] >> 4];
+      expected[b * 2 + 1] = kHex[r.expected[b] & 15];
+    }
+    expected[40] = '\0';
+    printf("  {\"%s\", \"%s\", %8u, %10u},\n", prev, expected,
+           (unsigned)r.difficulty, (unsigned)r.nonce);
+    seen.push_back(r.difficulty);
+    ++out;
+  }
+  fprintf(stderr, "kat: %u vectors from %zu records (%u synthetic skipped, %u did not verify)\n",
+          (unsigned)out, recs.size(), (unsigned)synth, (unsigned)wrong);
+  return out ? 0 : 1;
+}
+
+// ---------- 解き直し ----------
+struct ReplayResult {
+  uint32_t jobs       = 0;
+  uint32_t mismatches = 0;
+  uint64_t hashes     = 0;
+  double   sec        = 0.0;
+};
+
+static ReplayResult replay(const DucoS1Kernel& k, const std::vector<DucoTraceRecord>& recs,
+                           int repeat, bool verbose) {
+  ReplayResult res;
+  DucoS1Control ctl;   // poll なし（打ち切らない）
+  std::vector<DucoS1Job> jobs(recs.size());
+  for (size_t i = 0; i < recs.size(); ++i) {
+    char prev[41];
+    duco_trace_prev_hex(recs[i], prev);
+    duco_s1_prepare(jobs[i], prev, DUCO_S1_SEED_LEN);
+    duco_s1_set_target(jobs[i], recs[i].expected);
+  }
+
+  const double t0 = nowSec();
+  for (int rep = 0; rep < repeat; ++rep) {
+    for (size_t i = 0; i < recs.size(); ++i) {
+      const DucoTraceRecord& r = recs[i];
+      uint32_t hashes = 0;
+      const uint32_t got = k.scan(jobs[i], 0, r.difficulty * 100u, hashes, ctl);
+      const uint32_t want = (r.nonce == 0xFFFFFFFFu) ? DUCO_S1_NOT_FOUND : r.nonce;
+      // LOST / BAD でも記録した nonce が答え（BAD は「古い」などサーバー側の理由もある）
+      if (got != want) {
+        ++res.mismatches;
+        if (verbose && rep == 0) {
+          fprintf(stderr, "  #%zu %s: diff=%u recorded=%u got=%u\n", i, k.name,
+                  (unsigned)r.difficulty, (unsigned)r.nonce, (unsigned)got);
+        }
+      }
+      res.hashes += hashes;
+      ++res.jobs;
+    }
+  }
+  res.sec = nowSec() - t0;
+  return res;
+}
+
+int main(int argc, char** argv) {
+  if (argc >= 2 && strcmp(argv[1], "synth") == 0) return runSynth(argc, argv);
+  if (argc >= 2 && strcmp(argv[1], "kat") == 0) return runKat(argc, argv);
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s <trace> [kernel=all|<name>] [repeat=1]\n"
+                    "       %s synth <out.bin> [n=200] [seed=1] [diffs=...]\n"
+                    "       %s kat <trace> [max=8]\n",
+            argv[0], argv[0], argv[0]);
+    return 1;
+  }
+
+  std::string kernel = "all";
+  int repeat = 1;
+  for (int i = 2; i < argc; ++i) {
+    if (strncmp(argv[i], "kernel=", 7) == 0) kernel = argv[i] + 7;
+    else if (strncmp(argv[i], "repeat=", 7) == 0) repeat = atoi(argv[i] + 7);
+    else {
+      fprintf(stderr, "unknown arg: %s\n", argv[i]);
+      return 1;
+    }
+  }
+  if (repeat < 1) repeat = 1;
+
+  std::vector<DucoTraceRecord> recs;
+  size_t skipped = 0;
+  if (!loadTrace(argv[1], recs, skipped)) return 1;
+
+  // トレースの中身（難易度の内訳・feedback・実機の速さ）
+  uint32_t fb[5] = {0};
+  uint64_t devHashes = 0, devUs = 0;
+  std::vector<std::pair<uint32_t, uint32_t> > diffMix;   // (difficulty, 件数)
+  uint32_t threads = 0;
+  for (size_t i = 0; i < recs.size(); ++i) {
+    const DucoTraceRecord& r = recs[i];
+    if (r.feedback < 5) ++fb[r.feedback];
+    devHashes += r.hashes;
+    devUs     += r.solve_us;
+    if (r.thread + 1u > threads) threads = r.thread + 1u;
+    size_t k = 0;
+    while (k < diffMix.size() && diffMix[k].first != r.difficulty) ++k;
+    if (k == diffMix.size()) diffMix.push_back(std::make_pair(r.difficulty, 0u));
+    ++diffMix[k].second;
+  }
+  printf("trace: %s  %zu records (%zu skipped)  workers=%u\n", argv[1], recs.size(), skipped,
+         (unsigned)threads);
+  printf("  feedback:");
+  for (int i = 0; i < 5; ++i) printf(" %s=%u", kFeedbackName[i], (unsigned)fb[i]);
+  printf("\n  diff:");
+  for (size_t k = 0; k < diffMix.size(); ++k) {
+    printf(" %u x%u", (unsigned)diffMix[k].first, (unsigned)diffMix[k].second);
+  }
+  printf("\n  device: %.1f kH/s per worker (hashes / solve time)\n",
+         devUs ? devHashes * 1000.0 / (double)devUs : 0.0);
+
+  std::vector<const DucoS1Kernel*> ks;
+  for (size_t i = 0; i < duco_s1_kernel_count(); ++i) {
+    const DucoS1Kernel* k = duco_s1_kernel_at(i);
+    if (kernel == "all" || kernel == k->name) ks.push_back(k);
+  }
+  if (ks.empty()) {
+    fprintf(stderr, "unknown kernel: %s\n", kernel.c_str());
+    return 1;
+  }
+
+  bool ok = true;
+  printf("%-10s %8s %10s %10s %10s\n", "kernel", "jobs", "jobs/s", "MH/s", "mismatch");
+  for (size_t i = 0; i < ks.size(); ++i) {
+    const ReplayResult r = replay(*ks[i], recs, repeat, true);
+    const double sec = r.sec > 0 ? r.sec : 1e-9;
+    printf("%-10s %8u %10.1f %10.2f %10u\n", ks[i]->name, (unsigned)r.jobs, r.jobs / sec,
+           r.hashes / sec / 1e6, (unsigned)r.mismatches);
+    if (r.mismatches) ok = false;
+  }
+  printf("%s\n", ok ? "replay OK" : "replay MISMATCH");
+  return ok ? 0 : 1;
+}